@@ -0,0 +1,32 @@
+[vertex]
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 camera_position;
+
+attribute vec3 position;
+attribute vec2 texcoords;
+// size, render range, draw offset x/y
+attribute vec4 cloud_parameters;
+
+varying vec2 fragtexcoords;
+varying vec4 fragcolor;
+
+void main()
+{
+    float alpha = max(0.0, 1.0 - length(camera_position - position) / cloud_parameters.y) * 0.8;
+    vec3 world_position = position + vec3(cloud_parameters.zw, 0.0);
+    fragtexcoords = texcoords;
+    gl_Position = projection * ((view * vec4(world_position, 1.0)) + vec4((texcoords.x - 0.5) * cloud_parameters.x, (texcoords.y - 0.5) * cloud_parameters.x, 0.0, 0.0));
+    fragcolor = vec4(alpha, alpha, alpha, 1.0);
+}
+
+[fragment]
+uniform sampler2D textureMap;
+
+varying vec4 fragcolor;
+varying vec2 fragtexcoords;
+
+void main()
+{
+    gl_FragColor = texture2D(textureMap, fragtexcoords.st) * fragcolor;
+}
@@ -5,12 +5,16 @@
 // Program inputs
 uniform mat4 projection;
 uniform mat4 view;
+uniform float time;
 
 // Per-vertex inputs
-attribute vec3 center;
+attribute vec3 start_center;
+attribute vec3 end_center;
+attribute vec3 start_color;
+attribute vec3 end_color;
+attribute vec2 size; // start, end
+attribute vec2 lifetime; // spawn time, duration
 attribute vec2 texcoords;
-attribute vec3 color;
-attribute float size;
 
 // Per-vertex outputs
 varying vec3 fragcolor;
@@ -18,13 +22,21 @@ varying vec2 fragtexcoords;
 
 void main()
 {
-    vec4 viewspace_center = view * vec4(center, 1.0);
-    vec4 viewspace_halfextents = vec4(texcoords.x - .5, texcoords.y - .5, 0., 0.) * size;
+    float age = time - lifetime.x;
+    float t = clamp(age / lifetime.y, 0.0, 1.0);
+    // Quadratic ease out, same as Tween::easeOutQuad
+    float f = t * (2.0 - t);
+
+    // Expired particles collapse into a degenerate quad.
+    float current_size = age > lifetime.y ? 0.0 : mix(size.x, size.y, f);
+
+    vec4 viewspace_center = view * vec4(mix(start_center, end_center, f), 1.0);
+    vec4 viewspace_halfextents = vec4(texcoords.x - .5, texcoords.y - .5, 0., 0.) * current_size;
 
     // Outputs to fragment shader
     gl_Position = projection * (viewspace_center + viewspace_halfextents);
     fragtexcoords = texcoords;
-    fragcolor = color;
+    fragcolor = mix(start_color, end_color, f);
 }
 
 [fragment]
@@ -1,4 +1,6 @@
 #include "components/internalrooms.h"
+#include <limits>
+#include <queue>
 
 
 glm::ivec2 InternalRooms::roomMin()
@@ -33,3 +35,128 @@ ShipSystem::Type InternalRooms::getSystemAtRoom(glm::ivec2 pos)
     }
     return ShipSystem::Type::None;
 }
+
+static bool isSameRooms(const std::vector<InternalRooms::Room>& a, const std::vector<InternalRooms::Room>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for(size_t n=0; n<a.size(); n++)
+        if (a[n].position != b[n].position || a[n].size != b[n].size)
+            return false;
+    return true;
+}
+
+static bool isSameDoors(const std::vector<InternalRooms::Door>& a, const std::vector<InternalRooms::Door>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for(size_t n=0; n<a.size(); n++)
+        if (a[n].position != b[n].position || a[n].horizontal != b[n].horizontal)
+            return false;
+    return true;
+}
+
+void InternalRooms::updateNavigationGraph()
+{
+    if (!navigation.edge_start.empty() && isSameRooms(rooms, navigation.rooms) && isSameDoors(doors, navigation.doors))
+        return;
+
+    navigation.rooms = rooms;
+    navigation.doors = doors;
+    navigation.origin = roomMin();
+    navigation.size = roomMax() - navigation.origin;
+    navigation.next_steps.clear();
+    navigation.edges.clear();
+
+    auto& origin = navigation.origin;
+    auto& size = navigation.size;
+    auto inside = [&](glm::ivec2 p) { return p.x >= origin.x && p.y >= origin.y && p.x < origin.x + size.x && p.y < origin.y + size.y; };
+    auto cell = [&](glm::ivec2 p) { return (p.y - origin.y) * size.x + (p.x - origin.x); };
+
+    // When rooms overlap, a cell belongs to the first room that contains it.
+    std::vector<const Room*> room_at(size.x * size.y, nullptr);
+    for(const auto& room : rooms)
+        for(int y=room.position.y; y<room.position.y + room.size.y; y++)
+            for(int x=room.position.x; x<room.position.x + room.size.x; x++)
+                if (!room_at[cell({x, y})])
+                    room_at[cell({x, y})] = &room;
+
+    navigation.edge_start.resize(size.x * size.y + 1);
+    for(int y=origin.y; y<origin.y + size.y; y++)
+    {
+        for(int x=origin.x; x<origin.x + size.x; x++)
+        {
+            glm::ivec2 pos{x, y};
+            int index = cell(pos);
+            navigation.edge_start[index] = navigation.edges.size();
+            if (auto room = room_at[index])
+            {
+                if (pos.x > room->position.x) navigation.edges.push_back({cell(pos + glm::ivec2{-1, 0}), 1.0f});
+                if (pos.x < room->position.x + room->size.x - 1) navigation.edges.push_back({cell(pos + glm::ivec2{1, 0}), 1.0f});
+                if (pos.y > room->position.y) navigation.edges.push_back({cell(pos + glm::ivec2{0, -1}), 1.0f});
+                if (pos.y < room->position.y + room->size.y - 1) navigation.edges.push_back({cell(pos + glm::ivec2{0, 1}), 1.0f});
+            }
+            for(const auto& door : doors)
+            {
+                glm::ivec2 other = door.horizontal ? glm::ivec2{0, 1} : glm::ivec2{1, 0};
+                if (door.position == pos && inside(pos - other)) navigation.edges.push_back({cell(pos - other), 1.1f});
+                if (door.position == pos + other && inside(pos + other)) navigation.edges.push_back({cell(pos + other), 1.1f});
+            }
+        }
+    }
+    navigation.edge_start.back() = navigation.edges.size();
+}
+
+const std::vector<int>& InternalRooms::getNextSteps(int target_cell)
+{
+    auto it = navigation.next_steps.find(target_cell);
+    if (it != navigation.next_steps.end())
+        return it->second;
+
+    // All walks are symmetric, so a single search outward from the target gives the first step from every cell.
+    auto cell_count = navigation.edge_start.size() - 1;
+    std::vector<float> distance(cell_count, std::numeric_limits<float>::infinity());
+    std::vector<int> next_step(cell_count, -1);
+    using QueueEntry = std::pair<float, int>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    distance[target_cell] = 0.0f;
+    next_step[target_cell] = target_cell;
+    queue.push({0.0f, target_cell});
+    while(!queue.empty())
+    {
+        auto [d, index] = queue.top();
+        queue.pop();
+        if (d > distance[index])
+            continue;
+        for(int e=navigation.edge_start[index]; e<navigation.edge_start[index + 1]; e++)
+        {
+            auto [other, cost] = navigation.edges[e];
+            if (d + cost < distance[other])
+            {
+                distance[other] = d + cost;
+                next_step[other] = index;
+                queue.push({d + cost, other});
+            }
+        }
+    }
+    return navigation.next_steps[target_cell] = std::move(next_step);
+}
+
+glm::ivec2 InternalRooms::getNextStep(glm::ivec2 start, glm::ivec2 target)
+{
+    updateNavigationGraph();
+    auto& origin = navigation.origin;
+    auto& size = navigation.size;
+    if (start == target)
+        return start;
+    if (start.x < origin.x || start.y < origin.y || start.x >= origin.x + size.x || start.y >= origin.y + size.y)
+        return start;
+    if (target.x < origin.x || target.y < origin.y || target.x >= origin.x + size.x || target.y >= origin.y + size.y)
+        return start;
+
+    auto& next_steps = getNextSteps((target.y - origin.y) * size.x + (target.x - origin.x));
+    int next = next_steps[(start.y - origin.y) * size.x + (start.x - origin.x)];
+    if (next < 0)
+        return start;
+    return origin + glm::ivec2{next % size.x, next / size.x};
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "components/shipsystem.h"
+#include <unordered_map>
 #include <vector>
 
 // Internal composition of a ship.
@@ -25,8 +26,27 @@ public:
     glm::ivec2 roomMin();
     glm::ivec2 roomMax();
     ShipSystem::Type getSystemAtRoom(glm::ivec2 pos);
+    // First step on the shortest walk from start to target through the rooms and doors,
+    //  or start itself if the target cannot be reached.
+    glm::ivec2 getNextStep(glm::ivec2 start, glm::ivec2 target);
 
     bool auto_repair_enabled = false; // Repair crew with auto target damaged rooms
+
+    // Walkable grid over the bounding box of the rooms. Rebuilt when the rooms or doors
+    //  differ from the copies it was built from, as those are modified directly by scripts and replication.
+    struct NavigationGraph
+    {
+        std::vector<Room> rooms;
+        std::vector<Door> doors;
+        glm::ivec2 origin{};
+        glm::ivec2 size{};
+        std::vector<int> edge_start; // Per cell, index of its first edge. One extra entry marks the end.
+        std::vector<std::pair<int, float>> edges; // Target cell and cost.
+        std::unordered_map<int, std::vector<int>> next_steps; // Per target cell, the cell to move to from each cell, -1 if unreachable.
+    } navigation;
+private:
+    void updateNavigationGraph();
+    const std::vector<int>& getNextSteps(int target_cell);
 };
 
 class InternalCrew
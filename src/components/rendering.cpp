@@ -1,5 +1,5 @@
 #include "mesh.h"
-#include "textureManager.h"
+#include "textureStreamer.h"
 #include "rendering.h"
 
 Mesh* MeshRenderComponent::getMesh()
@@ -12,21 +12,21 @@ Mesh* MeshRenderComponent::getMesh()
 sp::Texture* MeshRenderComponent::getTexture()
 {
     if (!texture.ptr && !texture.name.empty())
-        texture.ptr = textureManager.getTexture(texture.name);
+        texture.ptr = getStreamedTexture(texture.name);
     return texture.ptr;
 }
 
 sp::Texture* MeshRenderComponent::getSpecularTexture()
 {
     if (!specular_texture.ptr && !specular_texture.name.empty())
-        specular_texture.ptr = textureManager.getTexture(specular_texture.name);
+        specular_texture.ptr = getStreamedTexture(specular_texture.name);
     return specular_texture.ptr;
 }
 
 sp::Texture* MeshRenderComponent::getIlluminationTexture()
 {
     if (!illumination_texture.ptr && !illumination_texture.name.empty())
-        illumination_texture.ptr = textureManager.getTexture(illumination_texture.name);
+        illumination_texture.ptr = getStreamedTexture(illumination_texture.name);
     return illumination_texture.ptr;
 }
 
@@ -12,6 +12,8 @@
 #include "ecs/query.h"
 #include "menus/luaConsole.h"
 #include "playerInfo.h"
+#include "textureStreamer.h"
+#include "resources.h"
 #include <SDL_assert.h>
 
 P<GameGlobalInfo> gameGlobalInfo;
@@ -51,6 +53,7 @@ GameGlobalInfo::GameGlobalInfo()
     registerMemberReplication(&allow_main_screen_long_range_radar);
     registerMemberReplication(&gm_control_code);
     registerMemberReplication(&elapsed_time, 0.1);
+    registerMemberReplication(&texture_preload_manifest);
 }
 
 //due to a suspected compiler bug this deconstructor needs to be explicitly defined
@@ -101,6 +104,13 @@ void GameGlobalInfo::update(float delta)
     }
     elapsed_time += delta;
 
+    if (textureStreamer && texture_preload_manifest != preloaded_texture_manifest)
+    {
+        preloaded_texture_manifest = texture_preload_manifest;
+        if (texture_preload_manifest != "")
+            textureStreamer->preloadManifest(texture_preload_manifest);
+    }
+
     if (main_scenario_script && main_script_error_count < max_repeated_script_errors) {
         auto res = main_scenario_script->call<void>("update", delta);
         if (res.isErr() && res.error() != "Not a function") {
@@ -237,6 +247,7 @@ void GameGlobalInfo::reset()
     global_message = "";
     global_message_timeout = 0.0f;
     banner_string = "";
+    texture_preload_manifest = "";
 
     //Pause the game
     engine->setGameSpeed(0.0);
@@ -322,6 +333,11 @@ void GameGlobalInfo::startScenario(string filename, std::unordered_map<string, s
     // Initialize scenario settings.
     setScenarioSettings(filename, new_settings);
 
+    // Optional list of textures to stream in ahead of use, for example scenario_06_edgeofspace.preload.txt
+    string preload_manifest = filename.replace(".lua", ".preload.txt");
+    if (getResourceStream(preload_manifest))
+        texture_preload_manifest = preload_manifest;
+
     auto res = main_scenario_script->runFile<void>(filename);
     LuaConsole::checkResult(res);
     if (res.isOk()) {
@@ -59,6 +59,8 @@ public:
     float elapsed_time;
     string scenario;
     std::unordered_map<string, string> scenario_settings;
+    //Resource listing the textures this scenario uses, so clients can stream them in before they are first drawn.
+    string texture_preload_manifest;
 
     //List of script functions that can be called from the GM interface (Server only!)
     std::list<GMScriptCallback> gm_callback_functions;
@@ -122,6 +124,8 @@ private:
     sp::ecs::Entity victory_faction;
     int callsign_counter;
 
+    string preloaded_texture_manifest;
+
     int main_script_error_count = 0;
     static constexpr int max_repeated_script_errors = 5;
 
@@ -29,6 +29,15 @@ namespace gl
         {
             GL_CHECK(glDeleteTextures(count, textures));
         }
+
+        void createFramebuffers(size_t count, uint32_t* framebuffers)
+        {
+            GL_CHECK(glGenFramebuffers(count, framebuffers));
+        }
+        void deleteFramebuffers(size_t count, const uint32_t* framebuffers)
+        {
+            GL_CHECK(glDeleteFramebuffers(count, framebuffers));
+        }
     }
 
     ScopedBufferBinding::ScopedBufferBinding(uint32_t target, uint32_t buffer)
@@ -18,6 +18,9 @@ namespace gl
 
         void createTextures(size_t count, uint32_t* textures);
         void deleteTextures(size_t count, const uint32_t* textures);
+
+        void createFramebuffers(size_t count, uint32_t* framebuffers);
+        void deleteFramebuffers(size_t count, const uint32_t* framebuffers);
     }
 
     enum class Unitialized
@@ -157,6 +160,65 @@ namespace gl
         std::array<uint32_t, Count> buffers{ 0 };
     };
 
+    template<size_t Count>
+    class Framebuffers final
+    {
+    public:
+        Framebuffers()
+        {
+            details::createFramebuffers(buffers.size(), buffers.data());
+        }
+
+        explicit constexpr Framebuffers(Unitialized)
+        {
+        }
+
+        // Move-only type
+        Framebuffers(const Framebuffers&) = delete;
+        Framebuffers& operator=(const Framebuffers&) = delete;
+
+        Framebuffers(Framebuffers&& other)
+            :buffers{ std::move(other.buffers) }
+        {
+            for (auto& buffer : other.buffers)
+            {
+                buffer = 0;
+            }
+        }
+
+        Framebuffers& operator =(Framebuffers&& other)
+        {
+            if (buffers.data() != other.buffers.data())
+            {
+                reset();
+                buffers = std::move(other.buffers);
+                for (auto& buffer : other.buffers)
+                {
+                    buffer = 0;
+                }
+            }
+
+            return *this;
+        }
+
+        ~Framebuffers()
+        {
+            reset();
+        }
+
+        constexpr uint32_t operator[](size_t index) const
+        {
+            return buffers[index];
+        }
+    private:
+        void reset()
+        {
+            if (buffers[0] != 0)
+                details::deleteFramebuffers(buffers.size(), buffers.data());
+        }
+        std::array<uint32_t, Count> buffers{ 0 };
+    };
+
     class ScopedVertexAttribArray final
     {
     public:
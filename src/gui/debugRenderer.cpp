@@ -1,6 +1,9 @@
 #include "debugRenderer.h"
 #include "multiplayer_server.h"
+#include "playerInfo.h"
 #include "hotkeyConfig.h"
+#include "gui2_container.h"
+#include "textRunCache.h"
 
 
 DebugRenderer::DebugRenderer(RenderLayer* renderLayer)
@@ -40,12 +43,26 @@ void DebugRenderer::render(sp::RenderTarget& renderer)
     string text = "";
     if (show_fps)
         text = text + "FPS: " + string(fps) + "\n";
+    //Always take the counts, so they do not accumulate while hidden.
+    int layout_update_count = GuiContainer::takeLayoutUpdateCount();
+    int text_cache_hits, text_cache_misses;
+    textRunCache.takeStatistics(text_cache_hits, text_cache_misses);
+    if (show_fps)
+    {
+        text = text + "GUI layouts: " + string(layout_update_count) + "\n";
+        text = text + "Text cache: " + string(text_cache_hits) + " hits, " + string(text_cache_misses) + " misses\n";
+    }
 
     if (show_datarate && game_server)
     {
         text = text + string(game_server->getSendDataRate() / 1000, 1) + " kb per second\n";
         text = text + string(game_server->getSendDataRatePerClient() / 1000, 1) + " kb per client\n";
     }
+    if (show_datarate && my_player_info)
+    {
+        auto& stats = my_player_info->getCommandStatistics();
+        text = text + "Commands: " + string(int(stats.sent)) + " sent, " + string(int(stats.coalesced)) + " coalesced, " + string(int(stats.packets)) + " packets\n";
+    }
 
     if (show_timing_graph)
     {
@@ -1,5 +1,6 @@
 #include "soundManager.h"
 #include "theme.h"
+#include "textRunCache.h"
 #include "gui2_button.h"
 #include "preferenceManager.h"
 
@@ -36,9 +37,9 @@ void GuiButton::onDraw(sp::RenderTarget& renderer)
             text_align = sp::Alignment::CenterRight;
         }
         renderer.drawRotatedSprite(icon_name, glm::vec2(icon_x, rect.position.y + rect.size.y * 0.5f), rect.size.y * 0.8f, icon_rotation, front.color);
-        renderer.drawText(text_rect, text, text_align, text_size > 0 ? text_size : front.size, front.font, front.color);
+        drawCachedText(renderer, text_rect, text, text_align, text_size > 0 ? text_size : front.size, front.font, front.color);
     }else{
-        renderer.drawText(rect, text, sp::Alignment::Center, text_size > 0 ? text_size : front.size, front.font, front.color);
+        drawCachedText(renderer, rect, text, sp::Alignment::Center, text_size > 0 ? text_size : front.size, front.font, front.color);
     }
 }
 
@@ -67,18 +68,24 @@ string GuiButton::getText() const
 
 GuiButton* GuiButton::setText(string text)
 {
+    if (this->text != text)
+        markRenderDirty();
     this->text = text;
     return this;
 }
 
 GuiButton* GuiButton::setTextSize(float size)
 {
+    if (text_size != size)
+        markRenderDirty();
     text_size = size;
     return this;
 }
 
 GuiButton* GuiButton::setIcon(string icon_name, sp::Alignment icon_alignment, float rotation)
 {
+    if (this->icon_name != icon_name || this->icon_alignment != icon_alignment || this->icon_rotation != rotation)
+        markRenderDirty();
     this->icon_name = icon_name;
     this->icon_alignment = icon_alignment;
     this->icon_rotation = rotation;
@@ -89,6 +96,7 @@ GuiButton* GuiButton::setStyle(const string& style)
 {
     back_style = theme->getStyle(style + ".back");
     front_style = theme->getStyle(style + ".front");
+    markRenderDirty();
     return this;
 }
 
@@ -0,0 +1,154 @@
+#include "gui2_cachedcontainer.h"
+#include "shaderRegistry.h"
+
+#include <graphics/opengl.h>
+#include <array>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+
+GuiCachedContainer::GuiCachedContainer(GuiContainer* owner, const string& id)
+: GuiElement(owner, id)
+{
+}
+
+void GuiCachedContainer::markLayoutDirty()
+{
+    cache_valid = false;
+    GuiElement::markLayoutDirty();
+}
+
+void GuiCachedContainer::markRenderDirty()
+{
+    cache_valid = false;
+    GuiElement::markRenderDirty();
+}
+
+void GuiCachedContainer::drawElements(glm::vec2 mouse_position, sp::Rect parent_rect, sp::RenderTarget& renderer)
+{
+    glm::ivec2 origin{renderer.virtualToPixelPosition(rect.position)};
+    glm::ivec2 extents{renderer.virtualToPixelPosition(rect.position + rect.size)};
+    glm::ivec2 size = extents - origin;
+    if (size.x <= 0 || size.y <= 0)
+        return;
+
+    //Hover is normally updated while drawing, which the children skip while the cache is valid.
+    if (cache_valid)
+        updateHoverTree(this, mouse_position);
+    if (!cache_valid || size != texture_size || origin != cache_origin || glm::ivec2(renderer.getPhysicalSize()) != cache_physical_size)
+        renderCache(mouse_position, renderer, origin, size);
+    drawCache(renderer, origin, size);
+}
+
+void GuiCachedContainer::updateHoverTree(GuiContainer* container, glm::vec2 mouse_position)
+{
+    for(GuiElement* element : container->children)
+    {
+        if (element->destroyed || !element->visible)
+            continue;
+        element->updateHover(mouse_position);
+        updateHoverTree(element, mouse_position);
+    }
+}
+
+void GuiCachedContainer::renderCache(glm::vec2 mouse_position, sp::RenderTarget& renderer, glm::ivec2 origin, glm::ivec2 size)
+{
+    // Make sure all the drawing up till now is no longer queued and passed to the GPU.
+    renderer.finish();
+
+    int32_t previous_framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+    int32_t previous_viewport[4];
+    glGetIntegerv(GL_VIEWPORT, previous_viewport);
+    if (!framebuffer[0])
+    {
+        framebuffer = gl::Framebuffers<1>{};
+        texture = gl::Textures<1>{};
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer[0]);
+    if (size != texture_size)
+    {
+        glBindTexture(GL_TEXTURE_2D, texture[0]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        // The cache is drawn back 1:1 in pixels.
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture[0], 0);
+        texture_size = size;
+    }
+
+    // Keep the window sized viewport, but shift it so our rect lands at the origin of the texture.
+    //  That way the children draw with the exact same pixel positions as they would without the cache.
+    glm::ivec2 physical_size{renderer.getPhysicalSize()};
+    glViewport(-origin.x, origin.y + size.y - physical_size.y, physical_size.x, physical_size.y);
+
+    float clear_color[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clear_color);
+    glClearColor(0.f, 0.f, 0.f, 0.f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glClearColor(clear_color[0], clear_color[1], clear_color[2], clear_color[3]);
+
+    // Accumulate alpha the way it would end up on screen, so the texture holds premultiplied colors.
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Mark the cache valid before drawing, so children that change while drawing invalidate it for the next frame.
+    cache_valid = true;
+    cache_origin = origin;
+    cache_physical_size = physical_size;
+    GuiElement::drawElements(mouse_position, rect, renderer);
+    renderer.finish();
+
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glBindFramebuffer(GL_FRAMEBUFFER, previous_framebuffer);
+    glViewport(previous_viewport[0], previous_viewport[1], previous_viewport[2], previous_viewport[3]);
+}
+
+void GuiCachedContainer::drawCache(sp::RenderTarget& renderer, glm::ivec2 origin, glm::ivec2 size)
+{
+    renderer.finish();
+
+    auto physical_size = glm::vec2(renderer.getPhysicalSize());
+    glm::vec2 p0 = glm::vec2(origin) / physical_size * 2.f - 1.f;
+    glm::vec2 p1 = glm::vec2(origin + size) / physical_size * 2.f - 1.f;
+    struct VertexAndTexCoords
+    {
+        glm::vec3 vertex;
+        glm::vec2 texcoords;
+    };
+    // Pixel rows count down from the top, clip space and texture rows count up from the bottom.
+    std::array<VertexAndTexCoords, 4> quad{
+        glm::vec3{p0.x, -p0.y, 0.f}, {0.f, 1.f},
+        glm::vec3{p0.x, -p1.y, 0.f}, {0.f, 0.f},
+        glm::vec3{p1.x, -p0.y, 0.f}, {1.f, 1.f},
+        glm::vec3{p1.x, -p1.y, 0.f}, {1.f, 0.f}
+    };
+
+    ShaderRegistry::ScopedShader shader(ShaderRegistry::Shaders::Basic);
+    auto identity = glm::identity<glm::mat4>();
+    glUniformMatrix4fv(shader.get().uniform(ShaderRegistry::Uniforms::Projection), 1, GL_FALSE, glm::value_ptr(identity));
+    glUniformMatrix4fv(shader.get().uniform(ShaderRegistry::Uniforms::View), 1, GL_FALSE, glm::value_ptr(identity));
+    glUniformMatrix4fv(shader.get().uniform(ShaderRegistry::Uniforms::Model), 1, GL_FALSE, glm::value_ptr(identity));
+    glUniform4f(shader.get().uniform(ShaderRegistry::Uniforms::Color), 1.f, 1.f, 1.f, 1.f);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture[0]);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    {
+        gl::ScopedVertexAttribArray positions(shader.get().attribute(ShaderRegistry::Attributes::Position));
+        gl::ScopedVertexAttribArray texcoords(shader.get().attribute(ShaderRegistry::Attributes::Texcoords));
+        glVertexAttribPointer(positions.get(), 3, GL_FLOAT, GL_FALSE, sizeof(VertexAndTexCoords), (GLvoid*)quad.data());
+        glVertexAttribPointer(texcoords.get(), 2, GL_FLOAT, GL_FALSE, sizeof(VertexAndTexCoords), (GLvoid*)((char*)quad.data() + sizeof(glm::vec3)));
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    }
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // The basic shader is shared with the 3D views, give it back their matrices.
+    auto projection = ShaderRegistry::getActiveProjection();
+    auto view = ShaderRegistry::getActiveView();
+    glUniformMatrix4fv(shader.get().uniform(ShaderRegistry::Uniforms::Projection), 1, GL_FALSE, glm::value_ptr(projection));
+    glUniformMatrix4fv(shader.get().uniform(ShaderRegistry::Uniforms::View), 1, GL_FALSE, glm::value_ptr(view));
+}
@@ -0,0 +1,34 @@
+#ifndef GUI2_CACHEDCONTAINER_H
+#define GUI2_CACHEDCONTAINER_H
+
+#include "gui2_element.h"
+#include "glObjects.h"
+
+
+//Container that renders its children into an offscreen texture, and draws that texture until one of the children reports a change.
+//  Only put widgets in here that report their changes with markRenderDirty(), and that do not draw with their own GL state (stencil, depth, viewports).
+//  Children are not drawn while the cache is valid, so they should not update their state from onDraw.
+//  Animated or per frame updated widgets gain nothing from this, as they invalidate the cache every frame.
+class GuiCachedContainer : public GuiElement
+{
+public:
+    GuiCachedContainer(GuiContainer* owner, const string& id);
+
+    virtual void markLayoutDirty() override;
+    virtual void markRenderDirty() override;
+protected:
+    virtual void drawElements(glm::vec2 mouse_position, sp::Rect parent_rect, sp::RenderTarget& renderer) override;
+private:
+    void renderCache(glm::vec2 mouse_position, sp::RenderTarget& renderer, glm::ivec2 origin, glm::ivec2 size);
+    void drawCache(sp::RenderTarget& renderer, glm::ivec2 origin, glm::ivec2 size);
+    void updateHoverTree(GuiContainer* container, glm::vec2 mouse_position);
+
+    bool cache_valid = false;
+    glm::ivec2 cache_origin{0, 0};
+    glm::ivec2 cache_physical_size{0, 0};
+    glm::ivec2 texture_size{0, 0};
+    gl::Framebuffers<1> framebuffer{ gl::Unitialized{} };
+    gl::Textures<1> texture{ gl::Unitialized{} };
+};
+
+#endif//GUI2_CACHEDCONTAINER_H
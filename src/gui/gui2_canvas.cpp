@@ -112,12 +112,14 @@ void GuiCanvas::focus(GuiElement* element)
     if (focus_element)
     {
         focus_element->focus = false;
+        focus_element->markRenderDirty();
         focus_element->onFocusLost();
     }
     focus_element = element;
     if (focus_element)
     {
         focus_element->focus = true;
+        focus_element->markRenderDirty();
         focus_element->onFocusGained();
     }
 }
@@ -144,12 +146,13 @@ void GuiCanvas::runUpdates(GuiContainer* parent)
 
             //Delete it from our list.
             it = parent->children.erase(it);
+            parent->markLayoutDirty();
 
             // Free up the memory used by the element.
             element->owner = nullptr;
             delete element;
         }else{
-            element->hover = element->rect.contains(mouse_position);
+            element->updateHover(mouse_position);
             element->hover_coordinates = mouse_position;
 
             element->onUpdate();
@@ -2,6 +2,8 @@
 #include "gui2_element.h"
 #include "gui2_canvas.h"
 
+int GuiContainer::layout_update_count = 0;
+
 GuiContainer::~GuiContainer()
 {
     for(GuiElement* element : children)
@@ -25,12 +27,13 @@ void GuiContainer::drawElements(glm::vec2 mouse_position, sp::Rect parent_rect,
 
             //Delete it from our list.
             it = children.erase(it);
+            markLayoutDirty();
 
             // Free up the memory used by the element.
             element->owner = nullptr;
             delete element;
         }else{
-            element->hover = element->rect.contains(mouse_position);
+            element->updateHover(mouse_position);
 
             if (element->visible)
             {
@@ -79,8 +82,26 @@ GuiElement* GuiContainer::getClickElement(sp::io::Pointer::Button button, glm::v
     return nullptr;
 }
 
+void GuiContainer::markLayoutDirty()
+{
+    layout_dirty = true;
+}
+
+int GuiContainer::takeLayoutUpdateCount()
+{
+    int count = layout_update_count;
+    layout_update_count = 0;
+    return count;
+}
+
 void GuiContainer::updateLayout(const sp::Rect& rect)
 {
+    if (!layout_dirty && layout_rect.position == rect.position && layout_rect.size == rect.size)
+        return;
+    layout_dirty = false;
+    layout_rect = rect;
+    layout_update_count++;
+
     this->rect = rect;
     if (layout_manager || !children.empty())
     {
@@ -116,6 +137,7 @@ void GuiContainer::updateLayout(const sp::Rect& rect)
 
 void GuiContainer::setAttribute(const string& key, const string& value)
 {
+    markLayoutDirty();
     if (key == "size")
     {
         auto p = value.partition(",");
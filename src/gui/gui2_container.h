@@ -53,9 +53,16 @@ public:
     GuiContainer() = default;
     virtual ~GuiContainer();
 
-    template<typename T> void setLayout() { layout_manager = std::make_unique<T>(); }
+    template<typename T> void setLayout() { layout_manager = std::make_unique<T>(); markLayoutDirty(); }
     void updateLayout(const sp::Rect& rect);
     const sp::Rect& getRect() const { return rect; }
+    //Request a new layout pass for this container and its parents. Needed after changing the layout info directly instead of through the setters.
+    virtual void markLayoutDirty();
+    //Report that this container draws differently than before, for cached parents. Widgets call this from their setters.
+    virtual void markRenderDirty() {}
+
+    //Number of containers that were actually laid out since the last call, for the debug renderer.
+    static int takeLayoutUpdateCount();
 
     virtual void setAttribute(const string& key, const string& value);
 protected:
@@ -68,6 +75,10 @@ protected:
     sp::Rect rect{0,0,0,0};
 private:
     std::unique_ptr<GuiLayout> layout_manager = nullptr;
+    //The layout of a container is only updated when it is dirty, or when its parent gives it a different rect.
+    bool layout_dirty = true;
+    sp::Rect layout_rect{0,0,0,0};
+    static int layout_update_count;
 };
 
 #endif//GUI2_CONTAINER_H
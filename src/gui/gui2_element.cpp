@@ -9,6 +9,7 @@ GuiElement::GuiElement(GuiContainer* owner, const string& id)
     owner->children.push_back(this);
     destroyed = false;
     theme = owner->theme;
+    owner->markLayoutDirty();
 }
 
 GuiElement::~GuiElement()
@@ -50,8 +51,35 @@ void GuiElement::setAttribute(const string& key, const string& value)
         GuiContainer::setAttribute(key, value);
 }
 
+static bool isSameSides(const GuiContainer::LayoutInfo::Sides& a, const GuiContainer::LayoutInfo::Sides& b)
+{
+    return a.left == b.left && a.right == b.right && a.top == b.top && a.bottom == b.bottom;
+}
+
+static bool isSameLayout(const GuiContainer::LayoutInfo& a, const GuiContainer::LayoutInfo& b)
+{
+    return a.position == b.position && a.alignment == b.alignment && a.size == b.size && a.span == b.span
+        && isSameSides(a.margin, b.margin) && isSameSides(a.padding, b.padding)
+        && a.fill_width == b.fill_width && a.fill_height == b.fill_height
+        && a.lock_aspect_ratio == b.lock_aspect_ratio && a.match_content_size == b.match_content_size;
+}
+
+void GuiElement::markLayoutDirty()
+{
+    GuiContainer::markLayoutDirty();
+    if (owner)
+        owner->markLayoutDirty();
+}
+
+void GuiElement::markRenderDirty()
+{
+    if (owner)
+        owner->markRenderDirty();
+}
+
 GuiElement* GuiElement::setSize(glm::vec2 size)
 {
+    auto previous = layout;
     layout.size = size;
     layout.match_content_size = false;
 
@@ -71,6 +99,9 @@ GuiElement* GuiElement::setSize(glm::vec2 size)
         layout.size.y = layout.size.x;
         layout.lock_aspect_ratio = true;
     }
+    //Widgets often set their size every frame, only an actual change needs a new layout.
+    if (!isSameLayout(previous, layout))
+        markLayoutDirty();
     return this;
 }
 
@@ -86,38 +117,53 @@ glm::vec2 GuiElement::getSize() const
 
 GuiElement* GuiElement::setMargins(float n)
 {
+    auto previous = layout;
     layout.margin.left = layout.margin.top = layout.margin.right = layout.margin.bottom = n;
+    if (!isSameLayout(previous, layout))
+        markLayoutDirty();
     return this;
 }
 
 GuiElement* GuiElement::setMargins(float x, float y)
 {
+    auto previous = layout;
     layout.margin.left = layout.margin.right = x;
     layout.margin.top = layout.margin.bottom = y;
+    if (!isSameLayout(previous, layout))
+        markLayoutDirty();
     return this;
 }
 
 GuiElement* GuiElement::setMargins(float left, float top, float right, float bottom)
 {
+    auto previous = layout;
     layout.margin.left = left;
     layout.margin.top = top;
     layout.margin.right = right;
     layout.margin.bottom = bottom;
+    if (!isSameLayout(previous, layout))
+        markLayoutDirty();
     return this;
 }
 
 GuiElement* GuiElement::setPosition(float x, float y, sp::Alignment alignment)
 {
+    auto previous = layout;
     layout.position.x = x;
     layout.position.y = y;
     layout.alignment = alignment;
+    if (!isSameLayout(previous, layout))
+        markLayoutDirty();
     return this;
 }
 
 GuiElement* GuiElement::setPosition(glm::vec2 position, sp::Alignment alignment)
 {
+    auto previous = layout;
     layout.position = position;
     layout.alignment = alignment;
+    if (!isSameLayout(previous, layout))
+        markLayoutDirty();
     return this;
 }
 
@@ -128,6 +174,8 @@ glm::vec2 GuiElement::getPositionOffset() const
 
 GuiElement* GuiElement::setVisible(bool visible)
 {
+    if (this->visible != visible)
+        markLayoutDirty();
     this->visible = visible;
     return this;
 }
@@ -151,6 +199,8 @@ bool GuiElement::isVisible() const
 
 GuiElement* GuiElement::setEnable(bool enable)
 {
+    if (this->enabled != enable)
+        markRenderDirty();
     this->enabled = enable;
     return this;
 }
@@ -178,6 +228,7 @@ void GuiElement::moveToFront()
     {
         owner->children.remove(this);
         owner->children.push_back(this);
+        owner->markLayoutDirty();
     }
 }
 
@@ -187,6 +238,7 @@ void GuiElement::moveToBack()
     {
         owner->children.remove(this);
         owner->children.push_front(this);
+        owner->markLayoutDirty();
     }
 }
 
@@ -211,6 +263,7 @@ GuiContainer* GuiElement::getTopLevelContainer()
 void GuiElement::destroy()
 {
     destroyed = true;
+    markLayoutDirty();
 }
 
 bool GuiElement::isDestroyed()
@@ -218,6 +271,16 @@ bool GuiElement::isDestroyed()
     return destroyed;
 }
 
+void GuiElement::updateHover(glm::vec2 mouse_position)
+{
+    bool new_hover = rect.contains(mouse_position);
+    if (hover != new_hover)
+    {
+        hover = new_hover;
+        markRenderDirty();
+    }
+}
+
 glm::u8vec4 GuiElement::selectColor(const ColorSet& color_set) const
 {
     if (!enabled)
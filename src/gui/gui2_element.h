@@ -53,6 +53,8 @@ public:
     virtual void onFocusLost() {}
 
     virtual void setAttribute(const string& key, const string& value) override;
+    virtual void markLayoutDirty() override;
+    virtual void markRenderDirty() override;
     GuiElement* setSize(glm::vec2 size);
     GuiElement* setSize(float x, float y);
     glm::vec2 getSize() const;
@@ -87,8 +89,10 @@ public:
 
     friend class GuiContainer;
     friend class GuiCanvas;
+    friend class GuiCachedContainer;
 
 protected:
+    void updateHover(glm::vec2 mouse_position);
     glm::u8vec4 selectColor(const ColorSet& color_set) const;
     State getState() const;
 };
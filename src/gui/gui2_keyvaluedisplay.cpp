@@ -1,6 +1,7 @@
 #include "textureManager.h"
 #include "gui2_keyvaluedisplay.h"
 #include "theme.h"
+#include "textRunCache.h"
 
 
 GuiKeyValueDisplay::GuiKeyValueDisplay(GuiContainer* owner, const string& id, float div_distance, const string& key, const string& value)
@@ -22,8 +23,8 @@ void GuiKeyValueDisplay::onDraw(sp::RenderTarget& renderer)
     renderer.drawStretched(rect, back.texture, color != glm::u8vec4{255, 255, 255, 255} ? color : back.color);
     if (rect.size.x >= rect.size.y)
     {
-        renderer.drawText(sp::Rect(rect.position.x, rect.position.y, rect.size.x * div_distance - div_size, rect.size.y), this->key, sp::Alignment::CenterRight, text_size, key.font, key.color);
-        renderer.drawText(sp::Rect(rect.position.x + rect.size.x * div_distance + div_size, rect.position.y, rect.size.x * (1.f - div_distance), rect.size.y), this->value, sp::Alignment::CenterLeft, text_size, value.font, value.color);
+        drawCachedText(renderer, sp::Rect(rect.position.x, rect.position.y, rect.size.x * div_distance - div_size, rect.size.y), this->key, sp::Alignment::CenterRight, text_size, key.font, key.color);
+        drawCachedText(renderer, sp::Rect(rect.position.x + rect.size.x * div_distance + div_size, rect.position.y, rect.size.x * (1.f - div_distance), rect.size.y), this->value, sp::Alignment::CenterLeft, text_size, value.font, value.color);
         if (icon_texture != "")
         {
             renderer.drawSprite(icon_texture, glm::vec2(rect.position.x + rect.size.y * 0.5f, rect.position.y + rect.size.y * 0.5f), rect.size.y * 0.8f, key.color);
@@ -31,37 +32,47 @@ void GuiKeyValueDisplay::onDraw(sp::RenderTarget& renderer)
     }
     else
     {
-        renderer.drawText(sp::Rect(rect.position.x, rect.position.y + rect.size.y * (1.f - div_distance) + div_size, rect.size.x, rect.size.y * div_distance - div_size), this->key, sp::Alignment::TopCenter, text_size, key.font, key.color, sp::Font::FlagVertical);
-        renderer.drawText(sp::Rect(rect.position.x, rect.position.y, rect.size.x, rect.size.y * (1.f - div_distance) - div_size), this->value, sp::Alignment::BottomCenter, text_size, value.font, value.color, sp::Font::FlagVertical);
+        drawCachedText(renderer, sp::Rect(rect.position.x, rect.position.y + rect.size.y * (1.f - div_distance) + div_size, rect.size.x, rect.size.y * div_distance - div_size), this->key, sp::Alignment::TopCenter, text_size, key.font, key.color, sp::Font::FlagVertical);
+        drawCachedText(renderer, sp::Rect(rect.position.x, rect.position.y, rect.size.x, rect.size.y * (1.f - div_distance) - div_size), this->value, sp::Alignment::BottomCenter, text_size, value.font, value.color, sp::Font::FlagVertical);
     }
 }
 
 GuiKeyValueDisplay* GuiKeyValueDisplay::setKey(const string& key)
 {
+    if (this->key != key)
+        markRenderDirty();
     this->key = key;
     return this;
 }
 
 GuiKeyValueDisplay* GuiKeyValueDisplay::setValue(const string& value)
 {
+    if (this->value != value)
+        markRenderDirty();
     this->value = value;
     return this;
 }
 
 GuiKeyValueDisplay* GuiKeyValueDisplay::setTextSize(float text_size)
 {
+    if (this->text_size != text_size)
+        markRenderDirty();
     this->text_size = text_size;
     return this;
 }
 
 GuiKeyValueDisplay* GuiKeyValueDisplay::setColor(glm::u8vec4 color)
 {
+    if (this->color != color)
+        markRenderDirty();
     this->color = color;
     return this;
 }
 
 GuiKeyValueDisplay* GuiKeyValueDisplay::setIcon(const string& icon_texture)
 {
+    if (this->icon_texture != icon_texture)
+        markRenderDirty();
     this->icon_texture = icon_texture;
     return this;
 }
@@ -1,5 +1,6 @@
 #include "gui2_label.h"
 #include "theme.h"
+#include "textRunCache.h"
 
 
 GuiLabel::GuiLabel(GuiContainer* owner, string id, string text, float text_size)
@@ -17,13 +18,15 @@ void GuiLabel::onDraw(sp::RenderTarget& renderer)
     if (background)
         renderer.drawStretched(rect, back.texture, back.color);
     if (vertical)
-        renderer.drawText(rect, text, text_alignment, text_size, front.font, front.color, sp::Font::FlagVertical);
+        drawCachedText(renderer, rect, text, text_alignment, text_size, front.font, front.color, sp::Font::FlagVertical);
     else
-        renderer.drawText(rect, text, text_alignment, text_size, front.font, front.color);
+        drawCachedText(renderer, rect, text, text_alignment, text_size, front.font, front.color);
 }
 
 GuiLabel* GuiLabel::setText(string text)
 {
+    if (this->text != text)
+        markRenderDirty();
     this->text = text;
     return this;
 }
@@ -35,6 +38,8 @@ string GuiLabel::getText() const
 
 GuiLabel* GuiLabel::setAlignment(sp::Alignment alignment)
 {
+    if (text_alignment != alignment)
+        markRenderDirty();
     text_alignment = alignment;
     return this;
 }
@@ -63,7 +68,7 @@ void GuiAutoSizeLabel::onDraw(sp::RenderTarget& renderer)
     
     if (background)
         renderer.drawStretched(rect, back.texture, back.color);
-    renderer.drawText(rect, text, text_alignment, text_size, front.font, front.color, sp::Font::FlagLineWrap);
+    drawCachedText(renderer, rect, text, text_alignment, text_size, front.font, front.color, sp::Font::FlagLineWrap);
 }
 
 void GuiAutoSizeLabel::onUpdate()
@@ -1,5 +1,6 @@
 #include "gui2_progressbar.h"
 #include "theme.h"
+#include "textRunCache.h"
 
 
 GuiProgressbar::GuiProgressbar(GuiContainer* owner, string id, float min_value, float max_value, float start_value)
@@ -33,17 +34,21 @@ void GuiProgressbar::onDraw(sp::RenderTarget& renderer)
         fill_rect.position.y = rect.position.y + rect.size.y - fill_rect.size.y;
         renderer.drawStretchedHVClipped(rect, fill_rect, front.size, front.texture, color);
     }
-    renderer.drawText(rect, text, sp::Alignment::Center);
+    drawCachedText(renderer, rect, text, sp::Alignment::Center);
 }
 
 GuiProgressbar* GuiProgressbar::setValue(float value)
 {
+    if (this->value != value)
+        markRenderDirty();
     this->value = value;
     return this;
 }
 
 GuiProgressbar* GuiProgressbar::setRange(float min_value, float max_value)
 {
+    if (this->min_value != min_value || this->max_value != max_value)
+        markRenderDirty();
     this->min_value = min_value;
     this->max_value = max_value;
     return this;
@@ -51,18 +56,24 @@ GuiProgressbar* GuiProgressbar::setRange(float min_value, float max_value)
 
 GuiProgressbar* GuiProgressbar::setText(string text)
 {
+    if (this->text != text)
+        markRenderDirty();
     this->text = text;
     return this;
 }
 
 GuiProgressbar* GuiProgressbar::setColor(glm::u8vec4 color)
 {
+    if (this->color != color)
+        markRenderDirty();
     this->color = color;
     return this;
 }
 
 GuiProgressbar* GuiProgressbar::setDrawBackground(bool drawBackground)
 {
+    if (this->drawBackground != drawBackground)
+        markRenderDirty();
     this->drawBackground = drawBackground;
     return this;
 }
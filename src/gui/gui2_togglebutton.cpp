@@ -52,6 +52,7 @@ GuiToggleButton* GuiToggleButton::setValue(bool value)
     if (this->value == value)
         return this;
     this->value = value;
+    markRenderDirty();
     return this;
 }
 
@@ -0,0 +1,70 @@
+#include "textRunCache.h"
+
+#include <functional>
+
+
+TextRunCache textRunCache;
+
+bool TextRunCache::Key::operator==(const Key& other) const
+{
+    return font == other.font && text_size == other.text_size && area_size == other.area_size && alignment == other.alignment && flags == other.flags && text == other.text;
+}
+
+size_t TextRunCache::KeyHash::operator()(const Key& key) const
+{
+    size_t hash = std::hash<std::string>()(key.text);
+    auto combine = [&hash](size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+    combine(std::hash<sp::Font*>()(key.font));
+    combine(std::hash<float>()(key.text_size));
+    combine(std::hash<float>()(key.area_size.x));
+    combine(std::hash<float>()(key.area_size.y));
+    combine(static_cast<size_t>(key.alignment));
+    combine(static_cast<size_t>(key.flags));
+    return hash;
+}
+
+const sp::Font::PreparedFontString& TextRunCache::get(sp::Font* font, const string& text, float text_size, glm::vec2 area_size, sp::Alignment alignment, int flags)
+{
+    Key key{text, font, text_size, area_size, alignment, flags};
+    auto it = current.find(key);
+    if (it != current.end())
+    {
+        hits++;
+        return it->second;
+    }
+
+    if (current.size() >= generation_size)
+    {
+        previous = std::move(current);
+        current.clear();
+    }
+
+    auto old = previous.find(key);
+    if (old != previous.end())
+    {
+        hits++;
+        auto node = previous.extract(old);
+        return current.insert(std::move(node)).position->second;
+    }
+
+    misses++;
+    auto prepared = font->prepare(text, 32, text_size, area_size, alignment, flags);
+    return current.emplace(std::move(key), std::move(prepared)).first->second;
+}
+
+void TextRunCache::takeStatistics(int& hits, int& misses)
+{
+    hits = this->hits;
+    misses = this->misses;
+    this->hits = 0;
+    this->misses = 0;
+}
+
+void drawCachedText(sp::RenderTarget& renderer, sp::Rect rect, const string& text, sp::Alignment alignment, float text_size, sp::Font* font, glm::u8vec4 color, int flags)
+{
+    if (!font)
+        font = sp::RenderTarget::getDefaultFont();
+    if (!font || text.empty())
+        return;
+    renderer.drawText(rect, textRunCache.get(font, text, text_size, rect.size, alignment, flags), text_size, color, flags);
+}
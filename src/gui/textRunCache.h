@@ -0,0 +1,53 @@
+#ifndef TEXT_RUN_CACHE_H
+#define TEXT_RUN_CACHE_H
+
+#include "stringImproved.h"
+#include "graphics/font.h"
+#include "graphics/renderTarget.h"
+
+#include <unordered_map>
+
+
+//Keeps the shaped (laid out) glyphs of drawn text across frames, so labels that show the same text every frame do not shape it again.
+//  Entries are keyed on the final UTF-8 text, so translated strings of any locale are cached like any other text.
+//  Glyphs are looked up in the font atlas at draw time, only their positions are cached.
+class TextRunCache
+{
+public:
+    const sp::Font::PreparedFontString& get(sp::Font* font, const string& text, float text_size, glm::vec2 area_size, sp::Alignment alignment, int flags);
+
+    //Hit and miss counts since the last call, for the debug renderer.
+    void takeStatistics(int& hits, int& misses);
+private:
+    struct Key
+    {
+        string text;
+        sp::Font* font;
+        float text_size;
+        glm::vec2 area_size;
+        sp::Alignment alignment;
+        int flags;
+
+        bool operator==(const Key& other) const;
+    };
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+    using Map = std::unordered_map<Key, sp::Font::PreparedFontString, KeyHash>;
+
+    //Two generations: text not drawn since the previous swap is dropped on the next one.
+    //  This keeps the cache bounded when values change every frame, without tracking usage per entry.
+    static constexpr size_t generation_size = 2048;
+    Map current;
+    Map previous;
+    int hits = 0;
+    int misses = 0;
+};
+
+extern TextRunCache textRunCache;
+
+//Same as sp::RenderTarget::drawText, but shapes the text through the textRunCache.
+void drawCachedText(sp::RenderTarget& renderer, sp::Rect rect, const string& text, sp::Alignment alignment = sp::Alignment::TopLeft, float text_size = 30, sp::Font* font = nullptr, glm::u8vec4 color = {255, 255, 255, 255}, int flags = 0);
+
+#endif//TEXT_RUN_CACHE_H
@@ -8,17 +8,13 @@ DMX512SerialDevice::DMX512SerialDevice()
     for(int n=0; n<1+512; n++)
         data_stream[n] = 0;
     channel_count = 512;
-    resend_delay = 25;
-    run_thread = false;
+    //DMX512 receivers expect a continuous stream, so every frame is sent, changed or not.
+    frame_interval = 0.025f;
+    keep_alive_interval = 0.0f;
 }
 
 DMX512SerialDevice::~DMX512SerialDevice()
 {
-    if (run_thread)
-    {
-        run_thread = false;
-        update_thread.join();
-    }
     if (port)
         delete port;
 }
@@ -31,32 +27,37 @@ bool DMX512SerialDevice::configure(std::unordered_map<string, string> settings)
         if (!port->isOpen())
         {
             LOG(ERROR) << "Failed to open port: " << settings["port"] << " for DMX512SerialDevice";
-            port = nullptr;
             delete port;
+            port = nullptr;
         }
     }
     if (settings.find("channels") != settings.end())
     {
         channel_count = std::max(1, std::min(512, settings["channels"].toInt()));
     }
-    if (settings.find("resend_delay") != settings.end())
-    {
-        resend_delay = settings["resend_delay"].toInt();
-    }
+    configureRates(settings);
     if (port)
     {
-        run_thread = true;
-        update_thread = std::move(std::thread(&DMX512SerialDevice::updateLoop, this));
+        //On the Open DMX USB controller, the RTS line is used to enable the RS485 transmitter.
+        port->clearRTS();
+
+        //Configure the port for straight DMX-512 protocol.
+        port->configure(250000, 8, SerialPort::NoParity, SerialPort::TwoStopbits);
         return true;
     }
     return false;
 }
 
-//Set a hardware channel output. Value is 0.0 to 1.0 for no to max output.
-void DMX512SerialDevice::setChannelData(int channel, float value)
+void DMX512SerialDevice::sendFrame(const float* channels)
 {
-    if (channel >= 0 && channel < channel_count)
-        data_stream[1+channel] = int((value * 255.0f) + 0.5f);
+    for(int n=0; n<channel_count; n++)
+        data_stream[1+n] = int((channels[n] * 255.0f) + 0.5f);
+
+    //Send a break to initiate transfer, break needs to be at least 88uSec (note, not all USB serial convertors implement BREAK sending)
+    port->sendBreak();
+
+    //Send the channel data.
+    port->send(data_stream, 1 + channel_count);
 }
 
 //Return the number of output channels supported by this device.
@@ -64,24 +65,3 @@ int DMX512SerialDevice::getChannelCount()
 {
     return channel_count;
 }
-
-void DMX512SerialDevice::updateLoop()
-{
-    //On the Open DMX USB controller, the RTS line is used to enable the RS485 transmitter.
-    port->clearRTS();
-
-    //Configure the port for straight DMX-512 protocol.
-    port->configure(250000, 8, SerialPort::NoParity, SerialPort::TwoStopbits);
-
-    while(run_thread)
-    {
-        //Send a break to initiate transfer, break needs to be at least 88uSec (note, not all USB serial convertors implement BREAK sending)
-        port->sendBreak();
-
-        //Send the channel data.
-        port->send(data_stream, 1 + channel_count);
-
-        //Delay a bit before sending again.
-        std::this_thread::sleep_for(std::chrono::milliseconds(resend_delay));
-    }
-}
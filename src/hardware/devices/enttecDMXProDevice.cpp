@@ -8,15 +8,13 @@ EnttecDMXProDevice::EnttecDMXProDevice()
     for(int n=0; n<512; n++)
         channel_data[n] = 0;
     channel_count = 512;
+    //The widget keeps repeating the last frame on the DMX line by itself.
+    frame_interval = 0.1f;
+    keep_alive_interval = 1.0f;
 }
 
 EnttecDMXProDevice::~EnttecDMXProDevice()
 {
-    if (run_thread)
-    {
-        run_thread = false;
-        update_thread.join();
-    }
     if (port)
         delete port;
 }
@@ -29,28 +27,35 @@ bool EnttecDMXProDevice::configure(std::unordered_map<string, string> settings)
         if (!port->isOpen())
         {
             LOG(ERROR) << "Failed to open port: " << settings["port"] << " for EnttecDMXProDevice";
-            port = nullptr;
             delete port;
+            port = nullptr;
         }
     }
     if (settings.find("channels") != settings.end())
     {
         channel_count = std::max(1, std::min(512, settings["channels"].toInt()));
     }
+    configureRates(settings);
     if (port)
     {
-        run_thread = true;
-        update_thread = std::thread(&EnttecDMXProDevice::updateLoop, this);
+        //Configuration does not real matter as it's just a virtual device.
+        port->configure(115200, 8, SerialPort::NoParity, SerialPort::OneStopBit);
         return true;
     }
     return false;
 }
 
-//Set a hardware channel output. Value is 0.0 to 1.0 for no to max output.
-void EnttecDMXProDevice::setChannelData(int channel, float value)
+void EnttecDMXProDevice::sendFrame(const float* channels)
 {
-    if (channel >= 0 && channel < channel_count)
-        channel_data[channel] = int((value * 255.0f) + 0.5f);
+    for(int n=0; n<channel_count; n++)
+        channel_data[n] = int((channels[n] * 255.0f) + 0.5f);
+
+    int size = channel_count + 1;
+    uint8_t start_code[5] = {0x7E, 0x06, uint8_t(size & 0xFF), uint8_t(size >> 8), 0x00};
+    uint8_t end_code[1] = {0xE7};
+    port->send(start_code, sizeof(start_code));
+    port->send(channel_data, channel_count);
+    port->send(end_code, sizeof(end_code));
 }
 
 //Return the number of output channels supported by this device.
@@ -58,22 +63,3 @@ int EnttecDMXProDevice::getChannelCount()
 {
     return channel_count;
 }
-
-void EnttecDMXProDevice::updateLoop()
-{
-    //Configuration does not real matter as it's just a virtual device.
-    port->configure(115200, 8, SerialPort::NoParity, SerialPort::OneStopBit);
-
-    int size = channel_count + 1;
-    uint8_t start_code[5] = {0x7E, 0x06, uint8_t(size & 0xFF), uint8_t(size >> 8), 0x00};
-    uint8_t end_code[1] = {0xE7};
-    while(run_thread)
-    {
-        port->send(start_code, sizeof(start_code));
-        port->send(channel_data, channel_count);
-        port->send(end_code, sizeof(end_code));
-
-        //Delay a bit before sending again.
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
-}
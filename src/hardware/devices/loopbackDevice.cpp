@@ -0,0 +1,42 @@
+#include "loopbackDevice.h"
+#include "logging.h"
+
+bool LoopbackOutputDevice::configure(std::unordered_map<string, string> settings)
+{
+    if (settings.find("channels") != settings.end())
+        channel_count = std::max(1, std::min(512, settings["channels"].toInt()));
+    if (settings.find("log") != settings.end())
+        log_changes = settings["log"].toInt() != 0;
+    configureRates(settings);
+    last_frame.assign(channel_count, 0.0f);
+    return true;
+}
+
+void LoopbackOutputDevice::sendFrame(const float* channels)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for(int n=0; n<channel_count; n++)
+    {
+        if (log_changes && last_frame[n] != channels[n])
+            LOG(DEBUG) << "Loopback channel " << (n + 1) << ": " << channels[n];
+        last_frame[n] = channels[n];
+    }
+    frame_count++;
+}
+
+int LoopbackOutputDevice::getChannelCount()
+{
+    return channel_count;
+}
+
+std::vector<float> LoopbackOutputDevice::getLastFrame()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return last_frame;
+}
+
+int LoopbackOutputDevice::getFrameCount()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return frame_count;
+}
@@ -0,0 +1,36 @@
+#ifndef LOOPBACK_DEVICE_H
+#define LOOPBACK_DEVICE_H
+
+#include <mutex>
+#include <vector>
+#include "hardware/hardwareOutputDevice.h"
+
+//The loopback device keeps the last frame it was sent in memory instead of sending it to hardware.
+//  For testing hardware.ini mappings and the output timing without any hardware attached.
+// Parameter: "channels" Amount of channels, default 512.
+// Parameter: "log" When set to 1, every changed channel is logged.
+class LoopbackOutputDevice : public HardwareOutputDevice
+{
+public:
+    LoopbackOutputDevice() = default;
+
+    //Configure the device.
+    virtual bool configure(std::unordered_map<string, string> settings) override;
+
+    virtual void sendFrame(const float* channels) override;
+
+    //Return the number of output channels supported by this device.
+    virtual int getChannelCount() override;
+
+    //Return a copy of the last frame that was sent to this device.
+    std::vector<float> getLastFrame();
+    int getFrameCount();
+private:
+    std::mutex mutex;
+    std::vector<float> last_frame;
+    int frame_count = 0;
+    int channel_count = 512;
+    bool log_changes = false;
+};
+
+#endif//LOOPBACK_DEVICE_H
@@ -9,20 +9,16 @@
 #include "io/json.h"
 
 #include "io/http/request.h"
+#include <thread>
 
 PhilipsHueDevice::PhilipsHueDevice()
 {
     userfile = "philips_hue.name";
-    run_thread = false;
+    keep_alive_interval = -1.0f;
 }
 
 PhilipsHueDevice::~PhilipsHueDevice()
 {
-    if (run_thread)
-    {
-        run_thread = false;
-        update_thread.join();
-    }
 }
 
 bool PhilipsHueDevice::configure(std::unordered_map<string, string> settings)
@@ -45,6 +41,11 @@ bool PhilipsHueDevice::configure(std::unordered_map<string, string> settings)
     {
         port = settings["port"].toInt();
     }
+    if (settings.find("rate_limit") != settings.end())
+    {
+        rate_limit = std::max(1, settings["rate_limit"].toInt());
+    }
+    configureRates(settings);
 
     //If no user name set, try to read it from the userfile.
     if (username == "")
@@ -151,6 +152,7 @@ bool PhilipsHueDevice::configure(std::unordered_map<string, string> settings)
                 }
 
                 lights.resize(light_count);
+                targets.resize(light_count);
 
                 FILE* f = fopen(userfile.c_str(), "wt");
                 if (f)
@@ -171,67 +173,114 @@ bool PhilipsHueDevice::configure(std::unordered_map<string, string> settings)
 
     if (username != "")
     {
-        run_thread = true;
-        update_thread = std::thread(&PhilipsHueDevice::updateLoop, this);
+        //A single request object is kept for the lifetime of the device, so the connection to the bridge is reused.
+        http = std::make_unique<sp::io::http::Request>(ip_address, port);
+        api_path = string{ "/api/" } + username;
+        last_budget_update = Clock::now();
+        last_latency_report = last_budget_update;
+        dirty_since.assign(light_count, last_budget_update);
         return true;
     }
     return false;
 }
 
-void PhilipsHueDevice::setChannelData(int channel, float value)
+int PhilipsHueDevice::getChannelCount()
 {
-    int light_idx = channel / 4;
-    if (light_idx < 0 || light_idx >= light_count)
-        return;
+    return light_count * 4;
+}
 
-    std::lock_guard<std::mutex> lock(mutex);
-    switch(channel % 4)
+string PhilipsHueDevice::stateJson(const LightInfo& info)
+{
+    if (info.brightness > 0)
+        return "{\"on\":true, \"sat\":"+string(info.saturation)+", \"bri\":"+string(info.brightness)+",\"hue\":"+string(info.hue)+", \"transitiontime\": "+string(info.transitiontime)+"}";
+    return "{\"on\":false, \"transitiontime\": "+string(info.transitiontime)+"}";
+}
+
+bool PhilipsHueDevice::put(const string& path, const string& data)
+{
+    auto response = http->request("put", api_path + path, data);
+    if (response.status != 200) // !OK
     {
-    case 0: if (lights[light_idx].brightness != value * 254) lights[light_idx].dirty = true; lights[light_idx].brightness = value * 254; break;
-    case 1: if (lights[light_idx].saturation != value * 254) lights[light_idx].dirty = true; lights[light_idx].saturation = value * 254; break;
-    case 2: if (lights[light_idx].hue != value * 65535) lights[light_idx].dirty = true; lights[light_idx].hue = value * 65535; break;
-    case 3: if (lights[light_idx].transitiontime != value) lights[light_idx].dirty = true; lights[light_idx].transitiontime = value; break;
+        LOG(WARNING) << "Failed to send " << path << " to philips hue bridge: " << response.status;
+        LOG(WARNING) << response.body;
+        return false;
     }
+    return true;
 }
 
-int PhilipsHueDevice::getChannelCount()
+void PhilipsHueDevice::sentLight(int index, Clock::time_point now)
 {
-    return light_count * 4;
+    static constexpr float average_factor = 0.1f;
+
+    lights[index] = targets[index];
+    lights[index].sent = true;
+    float latency = std::chrono::duration<float>(now - dirty_since[index]).count();
+    average_latency = average_latency * (1.0f - average_factor) + latency * average_factor;
+    max_latency = std::max(max_latency, latency);
 }
 
-void PhilipsHueDevice::updateLoop()
+void PhilipsHueDevice::sendFrame(const float* channels)
 {
-    sp::io::http::Request http(ip_address,port);
+    auto now = Clock::now();
+    command_budget = std::min(rate_limit, command_budget + std::chrono::duration<float>(now - last_budget_update).count() * rate_limit);
+    last_budget_update = now;
 
-    while(run_thread)
+    int dirty_count = 0;
+    bool all_equal = true;
+    for(int n=0; n<light_count; n++)
     {
-        for(int n=0; n<light_count; n++)
+        LightInfo& info = targets[n];
+        bool was_dirty = !lights[n].sent || lights[n] != info;
+        info.brightness = channels[n * 4 + 0] * 254;
+        info.saturation = channels[n * 4 + 1] * 254;
+        info.hue = channels[n * 4 + 2] * 65535;
+        info.transitiontime = channels[n * 4 + 3];
+
+        //The group command also reaches the lights that did not change, so it can only be used when all lights are equal.
+        if (info != targets[0])
+            all_equal = false;
+        if (lights[n].sent && lights[n] == info)
+            continue;
+        if (!was_dirty)
+            dirty_since[n] = now;
+        dirty_count++;
+    }
+
+    //Most effects (like red alert) change all lights the same way, the bridge handles that as a single group command.
+    if (dirty_count > 1 && all_equal && command_budget >= 1.0f && now - last_group_command >= std::chrono::seconds(1))
+    {
+        command_budget -= 1.0f;
+        last_group_command = now;
+        if (put("/groups/0/action", stateJson(targets[0])))
         {
-            if (lights[n].dirty)
-            {
-                LightInfo info;
-                {
-                    std::lock_guard<std::mutex> lock(mutex);
-                    lights[n].dirty = false;
-                    info = lights[n];
-                }
-                string post_data;
-                if (info.laststate != "sat-" + string(info.saturation) + "-bri-" + string(info.brightness) + "-hue-" + string(info.hue) + "-transition-" + string(info.transitiontime))
-                {
-                    lights[n].laststate = "sat-" + string(info.saturation) + "-bri-" + string(info.brightness) + "-hue-" + string(info.hue) + "-transition-" + string(info.transitiontime);
-                    if (info.brightness > 0)
-                        post_data = "{\"on\":true, \"sat\":"+string(info.saturation)+", \"bri\":"+string(info.brightness)+",\"hue\":"+string(info.hue)+", \"transitiontime\": "+string(info.transitiontime)+"}";
-                    else
-                        post_data = "{\"on\":false, \"transitiontime\": "+string(info.transitiontime)+"}";
-                    auto response = http.request("put", string{ "/api/" } + username + "/lights/" + string(n + 1) + "/state", post_data);
-                    if (response.status != 200) // !OK
-                    {
-                        LOG(WARNING) << "Failed to set light [" << (n + 1) << "] philips hue bridge: " << response.status;
-                        LOG(WARNING) << response.body;
-                    }
-                }
-            }
+            auto sent = Clock::now();
+            for(int n=0; n<light_count; n++)
+                if (!lights[n].sent || lights[n] != targets[n])
+                    sentLight(n, sent);
+            dirty_count = 0;
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    //Send the remaining lights round robin, so no light starves when the budget is too small for all of them.
+    for(int count=0; count<light_count && dirty_count > 0 && command_budget >= 1.0f; count++)
+    {
+        int n = next_light;
+        next_light = (next_light + 1) % light_count;
+        if (lights[n].sent && lights[n] == targets[n])
+            continue;
+        command_budget -= 1.0f;
+        dirty_count--;
+        if (put("/lights/" + string(n + 1) + "/state", stateJson(targets[n])))
+            sentLight(n, Clock::now());
+    }
+
+    //Coalesced lights still need to be sent, even when the frame does not change anymore.
+    keep_alive_interval = dirty_count > 0 ? 0.0f : -1.0f;
+
+    if (now - last_latency_report >= std::chrono::seconds(60))
+    {
+        LOG(DEBUG) << "Philips hue update latency: " << int(average_latency * 1000) << "ms avg, " << int(max_latency * 1000) << "ms max";
+        last_latency_report = now;
+        max_latency = 0.0f;
     }
 }
@@ -4,8 +4,11 @@
 #include "hardware/hardwareOutputDevice.h"
 
 #include <stdint.h>
-#include <thread>
-#include <mutex>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace sp::io::http { class Request; }
 
 //The PhilipsHueDevice talks to a philips hue bridge.
 //Documentation of the philips hue API is at:
@@ -17,6 +20,9 @@
 // Saturation
 // Hue
 // Transition Time
+//The bridge only handles about 10 light commands per second. Changes that do not fit in that budget are coalesced,
+//  only the latest state of a light is sent once there is room again. When all changed lights go to the same state,
+//  a single command for group 0 (all lights) is sent instead.
 class PhilipsHueDevice : public HardwareOutputDevice
 {
 public:
@@ -27,41 +33,62 @@ public:
     // Parameter: "ip": IP address of the bridge.
     // Parameter: "username": API username to use. If not set, will request a username from the bridge.
     // Parameter: "userfile": Filename to store the username API in, if not set with the user parameter and username is requested from the bridge.
+    // Parameter: "port": TCP port of the bridge, default 80. Together with "ip" this allows testing against a local mock bridge.
+    // Parameter: "rate_limit": Maximum light commands per second sent to the bridge, default 10.
     virtual bool configure(std::unordered_map<string, string> settings) override;
 
-    //Set a hardware channel output. Value is 0.0 to 1.0 for no to max output.
-    virtual void setChannelData(int channel, float value) override;
+    virtual void sendFrame(const float* channels) override;
 
     //Return the number of output channels supported by this device.
     virtual int getChannelCount() override;
 
+    //Every command is a HTTP request to the bridge.
+    virtual bool isBlocking() override { return true; }
+
 private:
+    using Clock = std::chrono::steady_clock;
+
     class LightInfo
     {
     public:
-        LightInfo() : dirty(true), brightness(0), saturation(0), hue(0), transitiontime(0), laststate(0) {}
-
-        bool dirty;
-        int brightness;
-        int saturation;
-        int hue;
-        int transitiontime;
-        string laststate;
-    };
+        bool sent = false;
+        int brightness = 0;
+        int saturation = 0;
+        int hue = 0;
+        int transitiontime = 0;
 
-    std::thread update_thread;
-    std::mutex mutex;
-    std::vector<LightInfo> lights;
+        bool operator==(const LightInfo& other) const { return brightness == other.brightness && saturation == other.saturation && hue == other.hue && transitiontime == other.transitiontime; }
+        bool operator!=(const LightInfo& other) const { return !(*this == other); }
+    };
 
-    bool run_thread;
+    string stateJson(const LightInfo& info);
+    bool put(const string& path, const string& data);
+    void sentLight(int index, Clock::time_point now);
 
-    void updateLoop();
+    //State last sent to each light, only lights that differ from it are sent again.
+    std::vector<LightInfo> lights;
+    //Latest requested state of each light, and since when it differs from the sent state.
+    std::vector<LightInfo> targets;
+    std::vector<Clock::time_point> dirty_since;
+    std::unique_ptr<sp::io::http::Request> http;
 
     string ip_address;
     int port = 80;
     string username;
     string userfile;
-    int light_count;
+    string api_path;
+    int light_count = 0;
+
+    float rate_limit = 10.0f;
+    float command_budget = 0.0f;
+    int next_light = 0;
+    Clock::time_point last_budget_update;
+    Clock::time_point last_group_command;
+
+    //Time between a light change arriving at the device and the bridge accepting it.
+    float average_latency = 0.0f;
+    float max_latency = 0.0f;
+    Clock::time_point last_latency_report;
 };
 
-#endif//S_ACN_DMX_DEVICE_H
+#endif//PHILIPS_HUE_DEVICE_H
@@ -6,29 +6,24 @@
 
 StreamingAcnDMXDevice::StreamingAcnDMXDevice()
 {
-    for(int n=0; n<512; n++)
-        channel_data[n] = 0;
     channel_count = 512;
 
     multicast = false;
-    resend_delay = 50;
+    frame_interval = 0.05f;
+    //E1.31 receivers hold the last values, but expect an unchanged universe to be repeated at least about once a second.
+    universe_keep_alive = 0.8f;
 
     universe = 1;
+    universe_count = 1;
     for(int n=0; n<16; n++)
         uuid[n] = uint8_t(irandom(0, 255));
     memset(source_name, 0, sizeof(source_name));
     strcpy((char*)source_name, "EmptyEpsilon");
-    run_thread = false;
     socket.bind(acn_port - 1);
 }
 
 StreamingAcnDMXDevice::~StreamingAcnDMXDevice()
 {
-    if (run_thread)
-    {
-        run_thread = false;
-        update_thread.join();
-    }
 }
 
 bool StreamingAcnDMXDevice::configure(std::unordered_map<string, string> settings)
@@ -41,79 +36,105 @@ bool StreamingAcnDMXDevice::configure(std::unordered_map<string, string> setting
     {
         universe = std::max(1, std::min(63999, settings["universe"].toInt()));
     }
-    if (settings.find("resend_delay") != settings.end())
+    if (settings.find("universes") != settings.end())
     {
-        resend_delay = std::max(1, settings["resend_delay"].toInt());
+        universe_count = std::max(1, std::min(max_universes, settings["universes"].toInt()));
+        universe_count = std::min(universe_count, 63999 - universe + 1);
     }
     if (settings.find("multicast") != settings.end())
     {
         multicast = settings["multicast"].toInt() != 0;
     }
+    keep_alive_interval = universe_keep_alive;
+    configureRates(settings);
+    //The keep alive is tracked per universe, so the scheduler has to offer us every frame.
+    universe_keep_alive = keep_alive_interval;
+    keep_alive_interval = 0.0f;
 
-    run_thread = true;
-    update_thread = std::thread(&StreamingAcnDMXDevice::updateLoop, this);
+    universes.resize(universe_count);
+    for(int n=0; n<universe_count; n++)
+    {
+        universes[n].number = universe + n;
+        buildPacket(universes[n]);
+    }
     return true;
 }
 
-//Set a hardware channel output. Value is 0.0 to 1.0 for no to max output.
-void StreamingAcnDMXDevice::setChannelData(int channel, float value)
+void StreamingAcnDMXDevice::buildPacket(Universe& u)
 {
-    if (channel >= 0 && channel < channel_count)
-        channel_data[channel] = int((value * 255.0f) + 0.5f);
+    u.sequence_number = 0;
+    u.sent_once = false;
+    u.packet.fill(0);
+
+    uint8_t* p = u.packet.data();
+    auto addU8 = [&p](uint8_t d) { *p++ = d; };
+    auto addU16 = [&p](uint16_t d) { *p++ = d >> 8; *p++ = d; };
+    auto addU32 = [&p](uint32_t d) { *p++ = d >> 24; *p++ = d >> 16; *p++ = d >> 8; *p++ = d; };
+
+    //Root layer
+    addU16(0x0010); //RLP Size
+    addU16(0x0000); //RLP Preamble size
+    for(char c : {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', '\0', '\0', '\0'})
+        addU8(c); //ACN Packet identifier
+    addU16(0x7000 | (110 + channel_count)); //Flags and length
+    addU32(0x0004); //Vector, identifies as PDU protocol
+    for(int n=0; n<16; n++)
+        addU8(uuid[n]);//Sender Unique ID, needs to be an UUID by spec. But most likely ignored by equipment.
+    //Framing layer
+    addU16(0x7000 | (88 + channel_count)); //Flags and length
+    addU32(0x0002); //Vector, identifies as DMP protocol PDU
+    for(int n=0; n<64; n++)
+        addU8(source_name[n]);//Source name, needs to be an UTF-8 zero terminated string. Only for ID goals.
+    addU8(100); //Priority
+    addU16(0);  //Reserved
+    addU8(0);  //sequence number, patched on send.
+    addU8(0);  //option flags
+    addU16(u.number);  //Universe number
+    //DMP layer
+    addU16(0x7000 | (11 + channel_count)); //Flags and length
+    addU8(2);  //Vector, message is PDU
+    addU8(0xa1);  //Format of address and data
+    addU16(0x0000);  //First property address
+    addU16(0x0001);  //Address increments
+    addU16(1 + channel_count);  //Value count
+    addU8(0x00); //DMX512 start byte.
+    //DMX slots follow, patched on send.
 }
 
 //Return the number of output channels supported by this device.
 int StreamingAcnDMXDevice::getChannelCount()
 {
-    return channel_count;
+    return channel_count * universe_count;
 }
 
-void StreamingAcnDMXDevice::updateLoop()
+void StreamingAcnDMXDevice::sendFrame(const float* channels)
 {
-    uint8_t sequence_number = 0;
-    while(run_thread)
+    auto now = std::chrono::steady_clock::now();
+    for(auto& u : universes)
     {
-        std::vector<uint8_t> buffer;
-        auto addU8 = [&buffer](uint8_t d) { buffer.resize(buffer.size() + 1); buffer[buffer.size()-1] = d; };
-        auto addU16 = [&buffer](uint16_t d) { buffer.resize(buffer.size() + 2); buffer[buffer.size()-2] = d >> 8; buffer[buffer.size()-1] = d; };
-        auto addU32 = [&buffer](uint16_t d) { buffer.resize(buffer.size() + 4); buffer[buffer.size()-4] = d >> 24; buffer[buffer.size()-3] = d >> 16; buffer[buffer.size()-2] = d >> 8; buffer[buffer.size()-1] = d; };
-
-        //Root layer
-        addU16(0x0010); //RLP Size
-        addU16(0x0000); //RLP Preamble size
-        addU8('A'); addU8('S'); addU8('C'); addU8('-'); addU8('E'); addU8('1'); addU8('.'); addU8('1'); addU8('7'); addU8('\0'); addU8('\0'); addU8('\0'); //ACN Packet identifier
-        addU16(0x7000 | (110 + channel_count)); //Flags and length
-        addU32(0x0004); //Vector, identifies as PDU protocol
-        for(int n=0; n<16; n++)
-            addU8(uuid[n]);//Sender Unique ID, needs to be an UUID by spec. But most likely ignored by equipment.
-        //Framing layer
-        addU16(0x7000 | (88 + channel_count)); //Flags and length
-        addU32(0x0002); //Vector, identifies as DMP protocol PDU
-        for(int n=0; n<64; n++)
-            addU8(source_name[n]);//Source name, needs to be an UTF-8 zero terminated string. Only for ID goals.
-        addU8(100); //Priority
-        addU16(0);  //Reserved
-        addU8(sequence_number);  //sequence number
-        addU8(0);  //option flags
-        addU16(universe);  //Universe number
-        //DMP layer
-        addU16(0x7000 | (11 + channel_count)); //Flags and length
-        addU8(2);  //Vector, message is PDU
-        addU8(0xa1);  //Format of address and data
-        addU16(0x0000);  //First property address
-        addU16(0x0001);  //Address increments
-        addU16(1 + channel_count);  //Value count
-        addU8(0x00); //DMX512 start byte.
+        uint8_t* slots = u.packet.data() + dmx_data_offset;
+        bool changed = !u.sent_once;
         for(int n=0; n<channel_count; n++)
-            addU8(channel_data[n]);
+        {
+            uint8_t value = uint8_t(channels[n] * 255.0f + 0.5f);
+            if (slots[n] != value)
+            {
+                slots[n] = value;
+                changed = true;
+            }
+        }
+        channels += channel_count;
 
-        sequence_number++;
+        if (!changed && (universe_keep_alive < 0.0f || now - u.last_send < std::chrono::duration<float>(universe_keep_alive)))
+            continue;
 
+        u.packet[sequence_number_offset] = u.sequence_number++;
+        size_t size = dmx_data_offset + channel_count;
         if (multicast)
-            socket.sendMulticast(buffer.data(), buffer.size(), universe, acn_port);
+            socket.sendMulticast(u.packet.data(), size, u.number, acn_port);
         else
-            socket.sendBroadcast(buffer.data(), buffer.size(), acn_port);
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(resend_delay));
+            socket.sendBroadcast(u.packet.data(), size, acn_port);
+        u.sent_once = true;
+        u.last_send = now;
     }
 }
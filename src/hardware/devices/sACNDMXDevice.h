@@ -4,47 +4,64 @@
 #include <io/network/udpSocket.h>
 #include "hardware/hardwareOutputDevice.h"
 
+#include <array>
+#include <chrono>
+#include <vector>
 #include <stdint.h>
-#include <thread>
 
 //The AcnDMXDevice talks the ACN E1.31 protocol. Which is an UDP protocol for sending DMX messages trough IP networks.
+//  A single device can output a range of consecutive universes, each one with "channels" channels.
 class StreamingAcnDMXDevice : public HardwareOutputDevice
 {
 private:
     static constexpr int acn_port = 5568;
+    static constexpr int max_universes = 64;
+    //Byte offsets in an E1.31 data packet.
+    static constexpr int sequence_number_offset = 111;
+    static constexpr int universe_offset = 113;
+    static constexpr int dmx_data_offset = 126;
+
+    struct Universe
+    {
+        int number;
+        uint8_t sequence_number;
+        bool sent_once;
+        std::chrono::steady_clock::time_point last_send;
+        //Preformatted packet, only the sequence number and the DMX slots change between sends.
+        std::array<uint8_t, dmx_data_offset + 512> packet;
+    };
 
-    std::thread update_thread;
     sp::io::network::UdpSocket socket;
 
-    bool run_thread;
     int channel_count;
-    uint8_t channel_data[512];
 
-    int resend_delay;
     bool multicast;
 
     int universe;
+    int universe_count;
+    float universe_keep_alive;
+    std::vector<Universe> universes;
     uint8_t uuid[16];
     uint8_t source_name[64];
+
+    void buildPacket(Universe& u);
 public:
     StreamingAcnDMXDevice();
     virtual ~StreamingAcnDMXDevice();
 
     //Configure the device.
-    // Parameter: "channels" amount of output channels used (default: 512)
+    // Parameter: "channels" amount of output channels used per universe (default: 512)
     // Parameter: "universe" which sACN universe to broadcast in. Default "1"
-    // Parameter: "resend_delay" Time between broadcast packets, in ms. Default "50"
+    // Parameter: "universes" amount of consecutive universes to output, starting at "universe". Default "1"
+    // Parameter: "resend_delay" Minimal time between packets of a universe, in ms. Default "50"
+    // Parameter: "keep_alive" Time after which an unchanged universe is sent again, in ms. Default "800"
     // Parameter: "multicast" Per default, sACN should be using multicast. But this implementation can also use broadcast. Default is to use broadcast. Set to 1 for multicast.
     virtual bool configure(std::unordered_map<string, string> settings) override;
 
-    //Set a hardware channel output. Value is 0.0 to 1.0 for no to max output.
-    virtual void setChannelData(int channel, float value) override;
+    virtual void sendFrame(const float* channels) override;
 
-    //Return the number of output channels supported by this device.
+    //Return the number of output channels supported by this device, over all universes.
     virtual int getChannelCount() override;
-
-private:
-    void updateLoop();
 };
 
 #endif//S_ACN_DMX_DEVICE_H
@@ -57,6 +57,7 @@ bool UDMXDevice::configure(std::unordered_map<string, string> settings)
         //return false;
     }
 
+    configureRates(settings);
     return true;
 #else
     LOG(ERROR) << "uDMX hardware not supported on this OS yet.";
@@ -64,11 +65,13 @@ bool UDMXDevice::configure(std::unordered_map<string, string> settings)
 #endif
 }
 
-//Set a hardware channel output. Value is 0.0 to 1.0 for no to max output.
-void UDMXDevice::setChannelData(int channel, float value)
+void UDMXDevice::sendFrame(const float* channels)
 {
 #ifdef _WIN32
-    UDMX_ChannelSet(channel, value * 255);
+    long values[512];
+    for(int n=0; n<512; n++)
+        values[n] = channels[n] * 255;
+    UDMX_ChannelsSet(512, 0, values);
 #endif
 }
 
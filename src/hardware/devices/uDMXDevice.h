@@ -14,8 +14,7 @@ public:
     //Configure the device.
     virtual bool configure(std::unordered_map<string, string> settings) override;
 
-    //Set a hardware channel output. Value is 0.0 to 1.0 for no to max output.
-    virtual void setChannelData(int channel, float value) override;
+    virtual void sendFrame(const float* channels) override;
 
     //Return the number of output channels supported by this device.
     virtual int getChannelCount() override;
@@ -19,6 +19,7 @@ public:
 VirtualOutputDevice::VirtualOutputDevice()
 {
     channel_count = 512;
+    frame_interval = 0.02f;
     for(int n=0; n<512; n++)
     {
         channel_data[n].value = 0;
@@ -39,6 +40,7 @@ bool VirtualOutputDevice::configure(std::unordered_map<string, string> settings)
     {
         channel_count = std::max(1, std::min(512, settings["channels"].toInt()));
     }
+    configureRates(settings);
     if (settings.find("virtual_types") != settings.end())
     {
         std::vector<string> virtual_types = settings["virtual_types"].split(",");
@@ -70,10 +72,10 @@ bool VirtualOutputDevice::configure(std::unordered_map<string, string> settings)
     return true;
 }
 
-void VirtualOutputDevice::setChannelData(int channel, float value)
+void VirtualOutputDevice::sendFrame(const float* channels)
 {
-    if (channel >= 0 && channel < 512)
-        channel_data[channel].value = value;
+    for(int n=0; n<channel_count; n++)
+        channel_data[n].value.store(channels[n], std::memory_order_relaxed);
 }
 
 //Return the number of output channels supported by this device.
@@ -91,21 +93,22 @@ void VirtualOutputDevice::render(sp::RenderTarget& renderer)
         for(int offset=0; offset<channel_data[n].composition; offset++)
         {
             ChannelData& data = channel_data[n + offset];
+            float value = data.value.load(std::memory_order_relaxed);
             switch(data.type)
             {
             case White:
-                color.r = std::min(255, int(color.r + data.value * 255));
-                color.g = std::min(255, int(color.g + data.value * 255));
-                color.b = std::min(255, int(color.b + data.value * 255));
+                color.r = std::min(255, int(color.r + value * 255));
+                color.g = std::min(255, int(color.g + value * 255));
+                color.b = std::min(255, int(color.b + value * 255));
                 break;
             case Red:
-                color.r = std::min(255, int(color.r + data.value * 255));
+                color.r = std::min(255, int(color.r + value * 255));
                 break;
             case Green:
-                color.g = std::min(255, int(color.g + data.value * 255));
+                color.g = std::min(255, int(color.g + value * 255));
                 break;
             case Blue:
-                color.b = std::min(255, int(color.b + data.value * 255));
+                color.b = std::min(255, int(color.b + value * 255));
                 break;
             }
         }
@@ -2,6 +2,7 @@
 #define VIRTUAL_OUTPUT_DEVICE_H
 
 #include <stdint.h>
+#include <atomic>
 #include "graphics/renderTarget.h"
 #include "hardware/hardwareOutputDevice.h"
 
@@ -19,7 +20,7 @@ private:
     };
     struct ChannelData
     {
-        float value;
+        std::atomic<float> value; //Written by the hardware I/O thread, read when rendering.
         EOutputType type;
         int composition;
     };
@@ -35,8 +36,7 @@ public:
     //Configure the device.
     virtual bool configure(std::unordered_map<string, string> settings) override;
 
-    //Set a hardware channel output. Value is 0.0 to 1.0 for no to max output.
-    virtual void setChannelData(int channel, float value) override;
+    virtual void sendFrame(const float* channels) override;
 
     //Return the number of output channels supported by this device.
     virtual int getChannelCount() override;
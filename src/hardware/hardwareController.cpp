@@ -4,6 +4,21 @@
 #include "gameGlobalInfo.h"
 #include "playerInfo.h"
 #include "ecs/query.h"
+#include "components/collision.h"
+#include "components/hull.h"
+#include "components/shields.h"
+#include "components/reactor.h"
+#include "components/impulse.h"
+#include "components/warpdrive.h"
+#include "components/docking.h"
+#include "components/jumpdrive.h"
+#include "components/player.h"
+#include "components/selfdestruct.h"
+#include "components/missiletubes.h"
+#include "components/radarblock.h"
+#include "systems/warpsystem.h"
+#include <glm/gtx/norm.hpp>
+#include <algorithm>
 
 #include "devices/dmx512SerialDevice.h"
 #include "devices/enttecDMXProDevice.h"
@@ -11,11 +26,13 @@
 #include "devices/sACNDMXDevice.h"
 #include "devices/uDMXDevice.h"
 #include "devices/philipsHueDevice.h"
+#include "devices/loopbackDevice.h"
 
 #include "hardwareMappingEffects.h"
 
 HardwareController::~HardwareController()
 {
+    io_scheduler.stop();
     for(HardwareOutputDevice* device : devices)
         delete device;
     for(HardwareMappingState& state : states)
@@ -64,8 +81,11 @@ void HardwareController::loadConfiguration(string filename)
     channels.resize(0);
     for(HardwareOutputDevice* device : devices)
     {
+        io_scheduler.addDevice(device, int(channels.size()));
         channels.resize(channels.size() + device->getChannelCount(), 0.0f);
     }
+    io_scheduler.start();
+    statistics_timer.repeat(60.0f);
     LOG(INFO) << "Hardware subsystem initialized with: " << channels.size() << " channels";
 
     if (devices.size() < 1)
@@ -98,6 +118,8 @@ void HardwareController::handleConfig(string section, std::unordered_map<string,
             device = new UDMXDevice();
         else if (settings["device"] == "PhilipsHueDevice")
             device = new PhilipsHueDevice();
+        else if (settings["device"] == "LoopbackDevice")
+            device = new LoopbackOutputDevice();
         else
             LOG(ERROR) << "Unknown device definition in [hardware] section: " << settings["device"];
         if (device)
@@ -179,6 +201,13 @@ void HardwareController::update(float delta)
 {
     if (channels.size() < 1)
         return;
+    ship = my_spaceship;
+    if (!ship) {
+        for(auto [entity, pc] : sp::ecs::Query<PlayerControl>()) {
+            ship = entity;
+            break;
+        }
+    }
     for(float& value : channels)
         value = 0.0;
     for(HardwareMappingState& state : states)
@@ -245,11 +274,15 @@ void HardwareController::update(float delta)
         }
     }
 
-    int idx = 0;
-    for(HardwareOutputDevice* device : devices)
+    io_scheduler.publish(channels);
+
+    if (statistics_timer.isExpired())
     {
-        for(int n=0; n<device->getChannelCount(); n++)
-            device->setChannelData(n, channels[idx++]);
+        for(int n=0; n<io_scheduler.getDeviceCount(); n++)
+        {
+            auto stats = io_scheduler.getStatistics(n);
+            LOG(DEBUG) << "Hardware device " << n << ": " << stats.frames_sent << " frames, latency " << int(stats.average_latency * 1000) << "ms avg " << int(stats.max_latency * 1000) << "ms max, jitter " << int(stats.average_jitter * 1000) << "ms";
+        }
     }
 }
 
@@ -258,7 +291,7 @@ void HardwareController::createNewHardwareMappingState(int channel_number, std::
     string condition = settings["condition"];
 
     HardwareMappingState state;
-    state.variable = condition;
+    state.variable_name = condition;
     state.compare_operator = HardwareMappingState::Greater;
     state.compare_value = 0.0;
     state.channel_nr = channel_number;
@@ -275,17 +308,18 @@ void HardwareController::createNewHardwareMappingState(int channel_number, std::
         }
         if (condition.find(compare_string) > -1)
         {
-            state.variable = condition.substr(0, condition.find(compare_string)).strip();
+            state.variable_name = condition.substr(0, condition.find(compare_string)).strip();
             state.compare_operator = compare_operator;
             state.compare_value = condition.substr(condition.find(compare_string) + 1).strip().toFloat();
         }
     }
 
+    state.variable = compileVariable(state.variable_name);
     state.effect = createEffect(settings);
 
     if (state.effect)
     {
-        LOG(DEBUG) << "New hardware state: " << state.channel_nr << ":" << state.variable << " " << state.compare_operator << " " << state.compare_value;
+        LOG(DEBUG) << "New hardware state: " << state.channel_nr << ":" << state.variable_name << " " << state.compare_operator << " " << state.compare_value;
         states.push_back(state);
     }
 }
@@ -306,7 +340,8 @@ void HardwareController::createNewHardwareMappingEvent(int channel_number, std::
         event.compare_operator = HardwareMappingEvent::Increase;
         trigger = trigger.substr(1).strip();
     }
-    event.trigger_variable = trigger;
+    event.trigger_variable_name = trigger;
+    event.trigger_variable = compileVariable(trigger);
     event.channel_nr = channel_number;
     event.runtime = settings["runtime"].toFloat();
     event.previous_value = 0.0;
@@ -314,7 +349,7 @@ void HardwareController::createNewHardwareMappingEvent(int channel_number, std::
     event.effect = createEffect(settings);
     if (event.effect)
     {
-        LOG(DEBUG) << "New hardware event: " << event.channel_nr << ":" << event.trigger_variable << " " << event.compare_operator;
+        LOG(DEBUG) << "New hardware event: " << event.channel_nr << ":" << event.trigger_variable_name << " " << event.compare_operator;
         events.push_back(event);
     }
 }
@@ -340,71 +375,236 @@ HardwareMappingEffect* HardwareController::createEffect(std::unordered_map<strin
     return nullptr;
 }
 
-#define SHIP_VARIABLE(name, formula) if (variable_name == name) { if (ship) { value = (formula); return true; } return false; }
-bool HardwareController::getVariableValue(string variable_name, float& value)
+HardwareVariable HardwareController::compileVariable(const string& variable_name)
 {
-    auto ship = my_spaceship;
-    if (!ship) {
-        for(auto [entity, pc] : sp::ecs::Query<PlayerControl>()) {
-            ship = entity;
-            break;
-        }
-    }
+    static const std::pair<const char*, HardwareVariable::Type> simple_variables[] = {
+        {"Always", HardwareVariable::Type::Always},
+        {"HasShip", HardwareVariable::Type::HasShip},
+        {"Hull", HardwareVariable::Type::Hull},
+        {"Energy", HardwareVariable::Type::Energy},
+        {"ShieldsUp", HardwareVariable::Type::ShieldsUp},
+        {"ShieldsCalibrating", HardwareVariable::Type::ShieldsCalibrating},
+        {"Impulse", HardwareVariable::Type::Impulse},
+        {"Warp", HardwareVariable::Type::Warp},
+        {"Docking", HardwareVariable::Type::Docking},
+        {"Docked", HardwareVariable::Type::Docked},
+        {"InNebula", HardwareVariable::Type::InNebula},
+        {"IsJammed", HardwareVariable::Type::IsJammed},
+        {"Jumping", HardwareVariable::Type::Jumping},
+        {"Jumped", HardwareVariable::Type::Jumped},
+        {"Alert", HardwareVariable::Type::Alert},
+        {"YellowAlert", HardwareVariable::Type::YellowAlert},
+        {"RedAlert", HardwareVariable::Type::RedAlert},
+        {"SelfDestruct", HardwareVariable::Type::SelfDestruct},
+        {"SelfDestructCountdown", HardwareVariable::Type::SelfDestructCountdown},
+    };
+    static const std::pair<const char*, HardwareVariable::Type> indexed_variables[] = {
+        {"Shield", HardwareVariable::Type::Shield},
+        {"TubeLoaded", HardwareVariable::Type::TubeLoaded},
+        {"TubeLoading", HardwareVariable::Type::TubeLoading},
+        {"TubeUnloading", HardwareVariable::Type::TubeUnloading},
+        {"TubeFiring", HardwareVariable::Type::TubeFiring},
+    };
+    static const std::pair<const char*, HardwareVariable::Type> system_variables[] = {
+        {"health", HardwareVariable::Type::SystemHealth},
+        {"power", HardwareVariable::Type::SystemPower},
+        {"heat", HardwareVariable::Type::SystemHeat},
+        {"coolant", HardwareVariable::Type::SystemCoolant},
+        {"hacked", HardwareVariable::Type::SystemHacked},
+    };
 
-    if (variable_name == "Always")
+    HardwareVariable result;
+    for(auto [name, type] : simple_variables)
     {
-        value = 1.0;
-        return true;
+        if (variable_name == name)
+        {
+            result.type = type;
+            return result;
+        }
     }
-    if (variable_name == "HasShip")
+    if (variable_name == "FrontShield" || variable_name == "RearShield")
     {
-        value = bool(ship) ? 1.0f : 0.0f;
-        return true;
+        result.type = HardwareVariable::Type::Shield;
+        result.index = variable_name == "FrontShield" ? 0 : 1;
+        return result;
     }
-    //SHIP_VARIABLE("Hull", 100.0f * ship->hull_strength / ship->hull_max);
-    //SHIP_VARIABLE("FrontShield", ship->getShieldPercentage(0));
-    //SHIP_VARIABLE("RearShield", ship->getShieldPercentage(1));
-    //SHIP_VARIABLE("Shield0", ship->getShieldPercentage(0));
-    //SHIP_VARIABLE("Shield1", ship->getShieldPercentage(1));
-    //SHIP_VARIABLE("Shield2", ship->getShieldPercentage(2));
-    //SHIP_VARIABLE("Shield3", ship->getShieldPercentage(3));
-    //SHIP_VARIABLE("Shield4", ship->getShieldPercentage(4));
-    //SHIP_VARIABLE("Shield5", ship->getShieldPercentage(5));
-    //SHIP_VARIABLE("Shield6", ship->getShieldPercentage(6));
-    //SHIP_VARIABLE("Shield7", ship->getShieldPercentage(7));
-    //SHIP_VARIABLE("Energy", ship->energy_level * 100 / ship->max_energy_level);
-    //SHIP_VARIABLE("ShieldsUp", ship->shields_active ? 1.0f : 0.0f);
-    //SHIP_VARIABLE("ShieldsCalibrating", ship->shield_calibration_delay / ship->shield_calibration_time);
-    //SHIP_VARIABLE("Impulse", ship->current_impulse * ship->getSystemEffectiveness(SYS_Impulse));
-    //SHIP_VARIABLE("Warp", ship->current_warp * ship->getSystemEffectiveness(SYS_Warp));
-    //SHIP_VARIABLE("Docking", ship->docking_state == DS_Docking ? 1.0f : 0.0f);
-    //SHIP_VARIABLE("Docked", ship->docking_state == DS_Docked ? 1.0f : 0.0f);
-    //SHIP_VARIABLE("InNebula", Nebula::inNebula(ship->getPosition()) ? 1.0f : 0.0f);
-    //SHIP_VARIABLE("IsJammed", WarpJammer::isWarpJammed(ship->getPosition()) ? 1.0f : 0.0f);
-    //SHIP_VARIABLE("Jumping", ship->jump_delay > 0.0f ? 1.0f : 0.0f);
-    //SHIP_VARIABLE("Jumped", ship->jump_indicator > 0.0f ? 1.0f : 0.0f);
-    //SHIP_VARIABLE("Alert", ship->getAlertLevel() != AL_Normal ? 1.0f : 0.0f);
-    //SHIP_VARIABLE("YellowAlert", ship->getAlertLevel() == AL_YellowAlert ? 1.0f : 0.0f);
-    //SHIP_VARIABLE("RedAlert", ship->getAlertLevel() == AL_RedAlert ? 1.0f : 0.0f);
-    //SHIP_VARIABLE("SelfDestruct", ship->activate_self_destruct ? 1.0f : 0.0f);
-    //SHIP_VARIABLE("SelfDestructCountdown", ship->self_destruct_countdown / 10.0f);
-    //for(int n=0; n<max_weapon_tubes; n++)
+    for(auto [name, type] : indexed_variables)
     {
-        //SHIP_VARIABLE("TubeLoaded" + string(n), ship->weapon_tube[n].isLoaded() ? 1.0f : 0.0f);
-        //SHIP_VARIABLE("TubeLoading" + string(n), ship->weapon_tube[n].isLoading() ? 1.0f : 0.0f);
-        //SHIP_VARIABLE("TubeUnloading" + string(n), ship->weapon_tube[n].isUnloading() ? 1.0f : 0.0f);
-        //SHIP_VARIABLE("TubeFiring" + string(n), ship->weapon_tube[n].isFiring() ? 1.0f : 0.0f);
+        string number = variable_name.substr(string(name).length());
+        if (variable_name.startswith(name) && number.length() > 0 && std::all_of(number.begin(), number.end(), [](char c) { return c >= '0' && c <= '9'; }))
+        {
+            result.type = type;
+            result.index = number.toInt();
+            return result;
+        }
     }
+    //System variables are the system name without spaces followed by the value, compared case insensitive ("BeamWeaponsHeat").
+    string lower_name = variable_name.lower();
     for(int n=0; n<ShipSystem::COUNT; n++)
     {
-        //SHIP_VARIABLE(getSystemName(ESystem(n)).replace(" ", "") + "Health", ship->systems[n].health);
-        //SHIP_VARIABLE(getSystemName(ESystem(n)).replace(" ", "") + "Power", ship->systems[n].power_level / 3.0f);
-        //SHIP_VARIABLE(getSystemName(ESystem(n)).replace(" ", "") + "Heat", ship->systems[n].heat_level);
-        //SHIP_VARIABLE(getSystemName(ESystem(n)).replace(" ", "") + "Coolant", ship->systems[n].coolant_level);
-        //SHIP_VARIABLE(getSystemName(ESystem(n)).replace(" ", "") + "Hacked", ship->systems[n].hacked_level);
+        string system_name = getSystemName(ShipSystem::Type(n)).replace(" ", "").lower();
+        for(auto [suffix, type] : system_variables)
+        {
+            if (lower_name == system_name + suffix)
+            {
+                result.type = type;
+                result.index = n;
+                return result;
+            }
+        }
     }
 
     LOG(WARNING) << "Unknown variable: " << variable_name;
+    return result;
+}
+
+static float systemValue(sp::ecs::Entity ship, int index, float ShipSystem::* member)
+{
+    auto system = ShipSystem::get(ship, ShipSystem::Type(index));
+    return system ? system->*member : 0.0f;
+}
+
+bool HardwareController::getVariableValue(const HardwareVariable& variable, float& value)
+{
     value = 0.0;
-    return false;
+    switch(variable.type)
+    {
+    case HardwareVariable::Type::Unknown:
+        return false;
+    case HardwareVariable::Type::Always:
+        value = 1.0;
+        return true;
+    case HardwareVariable::Type::HasShip:
+        value = bool(ship) ? 1.0f : 0.0f;
+        return true;
+    default:
+        break;
+    }
+    if (!ship)
+        return false;
+
+    switch(variable.type)
+    {
+    case HardwareVariable::Type::Unknown:
+    case HardwareVariable::Type::Always:
+    case HardwareVariable::Type::HasShip:
+        break;
+    case HardwareVariable::Type::Hull:
+        if (auto hull = ship.getComponent<Hull>())
+            value = hull->max > 0.0f ? 100.0f * hull->current / hull->max : 0.0f;
+        break;
+    case HardwareVariable::Type::Shield:
+        if (auto shields = ship.getComponent<Shields>())
+            if (variable.index < int(shields->entries.size()))
+                value = shields->entries[variable.index].percentage();
+        break;
+    case HardwareVariable::Type::Energy:
+        if (auto reactor = ship.getComponent<Reactor>())
+            value = reactor->max_energy > 0.0f ? reactor->energy * 100.0f / reactor->max_energy : 0.0f;
+        break;
+    case HardwareVariable::Type::ShieldsUp:
+        if (auto shields = ship.getComponent<Shields>())
+            value = shields->active ? 1.0f : 0.0f;
+        break;
+    case HardwareVariable::Type::ShieldsCalibrating:
+        if (auto shields = ship.getComponent<Shields>())
+            value = shields->calibration_time > 0.0f ? shields->calibration_delay / shields->calibration_time : 0.0f;
+        break;
+    case HardwareVariable::Type::Impulse:
+        if (auto impulse = ship.getComponent<ImpulseEngine>())
+            value = impulse->actual * impulse->getSystemEffectiveness();
+        break;
+    case HardwareVariable::Type::Warp:
+        if (auto warp = ship.getComponent<WarpDrive>())
+            value = warp->current * warp->getSystemEffectiveness();
+        break;
+    case HardwareVariable::Type::Docking:
+        if (auto port = ship.getComponent<DockingPort>())
+            value = port->state == DockingPort::State::Docking ? 1.0f : 0.0f;
+        break;
+    case HardwareVariable::Type::Docked:
+        if (auto port = ship.getComponent<DockingPort>())
+            value = port->state == DockingPort::State::Docked ? 1.0f : 0.0f;
+        break;
+    case HardwareVariable::Type::InNebula:
+        if (auto transform = ship.getComponent<sp::Transform>())
+        {
+            for(auto [entity, block, block_transform] : sp::ecs::Query<RadarBlock, sp::Transform>())
+            {
+                if (glm::length2(block_transform.getPosition() - transform->getPosition()) < block.range * block.range)
+                {
+                    value = 1.0f;
+                    break;
+                }
+            }
+        }
+        break;
+    case HardwareVariable::Type::IsJammed:
+        value = WarpSystem::isWarpJammed(ship) ? 1.0f : 0.0f;
+        break;
+    case HardwareVariable::Type::Jumping:
+        if (auto jump = ship.getComponent<JumpDrive>())
+            value = jump->delay > 0.0f ? 1.0f : 0.0f;
+        break;
+    case HardwareVariable::Type::Jumped:
+        if (auto jump = ship.getComponent<JumpDrive>())
+            value = jump->just_jumped > 0.0f ? 1.0f : 0.0f;
+        break;
+    case HardwareVariable::Type::Alert:
+        if (auto pc = ship.getComponent<PlayerControl>())
+            value = pc->alert_level != AlertLevel::Normal ? 1.0f : 0.0f;
+        break;
+    case HardwareVariable::Type::YellowAlert:
+        if (auto pc = ship.getComponent<PlayerControl>())
+            value = pc->alert_level == AlertLevel::YellowAlert ? 1.0f : 0.0f;
+        break;
+    case HardwareVariable::Type::RedAlert:
+        if (auto pc = ship.getComponent<PlayerControl>())
+            value = pc->alert_level == AlertLevel::RedAlert ? 1.0f : 0.0f;
+        break;
+    case HardwareVariable::Type::SelfDestruct:
+        if (auto self_destruct = ship.getComponent<SelfDestruct>())
+            value = self_destruct->active ? 1.0f : 0.0f;
+        break;
+    case HardwareVariable::Type::SelfDestructCountdown:
+        if (auto self_destruct = ship.getComponent<SelfDestruct>())
+            value = self_destruct->countdown / 10.0f;
+        break;
+    case HardwareVariable::Type::TubeLoaded:
+    case HardwareVariable::Type::TubeLoading:
+    case HardwareVariable::Type::TubeUnloading:
+    case HardwareVariable::Type::TubeFiring:
+        if (auto tubes = ship.getComponent<MissileTubes>())
+        {
+            if (variable.index < int(tubes->mounts.size()))
+            {
+                auto state = tubes->mounts[variable.index].state;
+                switch(variable.type)
+                {
+                case HardwareVariable::Type::TubeLoaded: value = state == MissileTubes::MountPoint::State::Loaded ? 1.0f : 0.0f; break;
+                case HardwareVariable::Type::TubeLoading: value = state == MissileTubes::MountPoint::State::Loading ? 1.0f : 0.0f; break;
+                case HardwareVariable::Type::TubeUnloading: value = state == MissileTubes::MountPoint::State::Unloading ? 1.0f : 0.0f; break;
+                case HardwareVariable::Type::TubeFiring: value = state == MissileTubes::MountPoint::State::Firing ? 1.0f : 0.0f; break;
+                default: break;
+                }
+            }
+        }
+        break;
+    case HardwareVariable::Type::SystemHealth:
+        value = systemValue(ship, variable.index, &ShipSystem::health);
+        break;
+    case HardwareVariable::Type::SystemPower:
+        value = systemValue(ship, variable.index, &ShipSystem::power_level) / 3.0f;
+        break;
+    case HardwareVariable::Type::SystemHeat:
+        value = systemValue(ship, variable.index, &ShipSystem::heat_level);
+        break;
+    case HardwareVariable::Type::SystemCoolant:
+        value = systemValue(ship, variable.index, &ShipSystem::coolant_level);
+        break;
+    case HardwareVariable::Type::SystemHacked:
+        value = systemValue(ship, variable.index, &ShipSystem::hacked_level);
+        break;
+    }
+    return true;
 }
@@ -3,8 +3,11 @@
 
 #include "engine.h"
 #include "hardwareOutputDevice.h"
+#include "hardwareIOScheduler.h"
+#include "hardwareVariable.h"
 #include "timer.h"
 #include "Updatable.h"
+#include "ecs/entity.h"
 
 
 class HardwareOutputDevice;
@@ -20,7 +23,8 @@ public:
         NotEqual
     };
 
-    string variable;
+    string variable_name;
+    HardwareVariable variable;
     EOperator compare_operator;
     float compare_value;
     int channel_nr;
@@ -37,7 +41,8 @@ public:
         Decrease
     };
 
-    string trigger_variable;
+    string trigger_variable_name;
+    HardwareVariable trigger_variable;
     float runtime;
     sp::Timer timer;
 
@@ -56,6 +61,9 @@ private:
     std::vector<HardwareMappingState> states;
     std::vector<HardwareMappingEvent> events;
     std::vector<float> channels;
+    HardwareIOScheduler io_scheduler;
+    sp::Timer statistics_timer;
+    sp::ecs::Entity ship; //Ship the variables are read from, updated once per frame.
 public:
     HardwareController() = default;
     ~HardwareController();
@@ -64,7 +72,11 @@ public:
 
     virtual void update(float delta) override;
 
-    bool getVariableValue(string variable_name, float& value);
+    HardwareVariable compileVariable(const string& variable_name);
+    bool getVariableValue(const HardwareVariable& variable, float& value);
+
+    int getDeviceCount() { return int(devices.size()); }
+    HardwareIOScheduler::DeviceStatistics getDeviceStatistics(int index) { return io_scheduler.getStatistics(index); }
 private:
     void handleConfig(string section, std::unordered_map<string, string>& settings);
     void createNewHardwareMappingState(int channel_number, std::unordered_map<string, string>& settings);
@@ -0,0 +1,133 @@
+#include "hardwareIOScheduler.h"
+#include "hardwareOutputDevice.h"
+
+#include <algorithm>
+
+
+HardwareIOScheduler::~HardwareIOScheduler()
+{
+    stop();
+}
+
+void HardwareIOScheduler::addDevice(HardwareOutputDevice* device, int first_channel)
+{
+    auto entry = std::make_unique<Device>();
+    entry->device = device;
+    entry->first_channel = first_channel;
+    devices.push_back(std::move(entry));
+}
+
+void HardwareIOScheduler::start()
+{
+    if (running || devices.empty())
+        return;
+
+    //All devices that don't block share the first lane, each blocking device gets a lane of its own.
+    lanes.push_back(std::make_unique<Lane>());
+    for(auto& device : devices)
+    {
+        if (device->device->isBlocking())
+        {
+            lanes.push_back(std::make_unique<Lane>());
+            lanes.back()->devices.push_back(device.get());
+        }else{
+            lanes.front()->devices.push_back(device.get());
+        }
+    }
+    if (lanes.front()->devices.empty())
+        lanes.erase(lanes.begin());
+
+    running = true;
+    for(auto& lane : lanes)
+        lane->thread = std::thread(&HardwareIOScheduler::run, this, std::ref(*lane));
+}
+
+void HardwareIOScheduler::stop()
+{
+    running = false;
+    for(auto& lane : lanes)
+        if (lane->thread.joinable())
+            lane->thread.join();
+}
+
+void HardwareIOScheduler::publish(const std::vector<float>& channels)
+{
+    auto now = Clock::now();
+    for(auto& lane : lanes)
+    {
+        auto& buffer = lane->buffer;
+        auto& frame = buffer.frames[buffer.write_index];
+        frame.channels.assign(channels.begin(), channels.end());
+        frame.time = now;
+        buffer.write_index = buffer.shared_index.exchange(buffer.write_index | FrameBuffer::new_frame_flag, std::memory_order_acq_rel) & ~FrameBuffer::new_frame_flag;
+    }
+}
+
+HardwareIOScheduler::DeviceStatistics HardwareIOScheduler::getStatistics(int device_index)
+{
+    DeviceStatistics result;
+    if (device_index < 0 || device_index >= int(devices.size()))
+        return result;
+    auto& device = *devices[device_index];
+    result.frames_sent = device.frames_sent.load(std::memory_order_relaxed);
+    result.average_latency = device.average_latency.load(std::memory_order_relaxed);
+    result.max_latency = device.max_latency.load(std::memory_order_relaxed);
+    result.average_jitter = device.average_jitter.load(std::memory_order_relaxed);
+    return result;
+}
+
+void HardwareIOScheduler::run(Lane& lane)
+{
+    static constexpr float average_factor = 0.05f;
+
+    auto& buffer = lane.buffer;
+    const Frame* frame = nullptr;
+    auto start_time = Clock::now();
+    for(auto device : lane.devices)
+        device->next_send = start_time;
+
+    while(running)
+    {
+        if (buffer.shared_index.load(std::memory_order_acquire) & FrameBuffer::new_frame_flag)
+        {
+            buffer.read_index = buffer.shared_index.exchange(buffer.read_index, std::memory_order_acq_rel) & ~FrameBuffer::new_frame_flag;
+            frame = &buffer.frames[buffer.read_index];
+        }
+
+        auto now = Clock::now();
+        auto next_wake = now + std::chrono::milliseconds(100);
+        for(auto device : lane.devices)
+        {
+            auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(device->device->getFrameInterval()));
+            int count = device->device->getChannelCount();
+            if (frame && now >= device->next_send && int(frame->channels.size()) >= device->first_channel + count)
+            {
+                const float* data = frame->channels.data() + device->first_channel;
+                bool changed = !device->sent_once || !std::equal(data, data + count, device->last_sent.begin());
+                float keep_alive = device->device->getKeepAliveInterval();
+                if (changed || (keep_alive >= 0.0f && now - device->last_send >= std::chrono::duration<float>(keep_alive)))
+                {
+                    float jitter = std::chrono::duration<float>(now - device->next_send).count();
+                    device->device->sendFrame(data);
+                    auto sent = Clock::now();
+                    float latency = std::chrono::duration<float>(sent - frame->time).count();
+
+                    device->last_sent.assign(data, data + count);
+                    device->sent_once = true;
+                    device->last_send = sent;
+                    device->frames_sent.fetch_add(1, std::memory_order_relaxed);
+                    device->average_latency.store(device->average_latency.load(std::memory_order_relaxed) * (1.0f - average_factor) + latency * average_factor, std::memory_order_relaxed);
+                    device->max_latency.store(std::max(device->max_latency.load(std::memory_order_relaxed), latency), std::memory_order_relaxed);
+                    device->average_jitter.store(device->average_jitter.load(std::memory_order_relaxed) * (1.0f - average_factor) + jitter * average_factor, std::memory_order_relaxed);
+                }
+                device->next_send += interval;
+                //When we fell behind, don't try to catch up with a burst of frames.
+                if (device->next_send < now)
+                    device->next_send = now + interval;
+            }
+            if (frame)
+                next_wake = std::min(next_wake, std::max(device->next_send, now + std::chrono::milliseconds(1)));
+        }
+        std::this_thread::sleep_until(next_wake);
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef HARDWARE_IO_SCHEDULER_H
+#define HARDWARE_IO_SCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class HardwareOutputDevice;
+
+//Sends the channel values of the game thread to all output devices.
+//  The game thread publishes complete frames through a lock free triple buffer, and an I/O thread
+//  sends each device its part of the latest frame at the device's own rate, skipping frames that did not change.
+//  Devices that block on slow I/O get their own I/O thread.
+class HardwareIOScheduler
+{
+public:
+    struct DeviceStatistics
+    {
+        int frames_sent = 0;
+        float average_latency = 0.0f; //Seconds between publishing a frame and sending it.
+        float max_latency = 0.0f;
+        float average_jitter = 0.0f; //Seconds between the scheduled and the actual send time.
+    };
+
+    HardwareIOScheduler() = default;
+    ~HardwareIOScheduler();
+
+    //Add a device that outputs channels [first_channel, first_channel + device->getChannelCount()). Only before start().
+    void addDevice(HardwareOutputDevice* device, int first_channel);
+    void start();
+    //Stop and join the I/O threads. Must be called before the devices are destroyed.
+    void stop();
+
+    //Publish a new frame with the values of all channels. Called from the game thread only.
+    void publish(const std::vector<float>& channels);
+
+    int getDeviceCount() { return int(devices.size()); }
+    DeviceStatistics getStatistics(int device_index);
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Frame
+    {
+        std::vector<float> channels;
+        Clock::time_point time;
+    };
+    //Single producer, single consumer triple buffer. The shared index carries a flag when it holds a frame the consumer has not seen.
+    struct FrameBuffer
+    {
+        static constexpr int new_frame_flag = 4;
+
+        Frame frames[3];
+        std::atomic<int> shared_index{1};
+        int write_index = 0; //Only used by the game thread.
+        int read_index = 2; //Only used by the I/O thread.
+    };
+    struct Device
+    {
+        HardwareOutputDevice* device;
+        int first_channel;
+        std::vector<float> last_sent;
+        bool sent_once = false;
+        Clock::time_point next_send;
+        Clock::time_point last_send;
+
+        std::atomic<int> frames_sent{0};
+        std::atomic<float> average_latency{0.0f};
+        std::atomic<float> max_latency{0.0f};
+        std::atomic<float> average_jitter{0.0f};
+    };
+    struct Lane
+    {
+        FrameBuffer buffer;
+        std::vector<Device*> devices;
+        std::thread thread;
+    };
+
+    void run(Lane& lane);
+
+    std::vector<std::unique_ptr<Device>> devices;
+    std::vector<std::unique_ptr<Lane>> lanes;
+    std::atomic<bool> running{false};
+};
+
+#endif//HARDWARE_IO_SCHEDULER_H
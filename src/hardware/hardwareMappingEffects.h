@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include "stringImproved.h"
 #include "timer.h"
+#include "hardwareVariable.h"
 
 class HardwareController;
 
@@ -61,7 +62,7 @@ class HardwareMappingEffectVariable : public HardwareMappingEffect
 {
 private:
     HardwareController* controller;
-    string variable_name;
+    HardwareVariable variable;
     float min_input, max_input;
     float min_output, max_output;
 public:
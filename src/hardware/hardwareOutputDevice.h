@@ -1,9 +1,12 @@
 #ifndef HARDWARE_OUTPUT_DEVICE_H
 #define HARDWARE_OUTPUT_DEVICE_H
 
+#include <algorithm>
 #include <unordered_map>
 #include "stringImproved.h"
 
+//Output devices do not run threads of their own. The HardwareIOScheduler calls sendFrame from its I/O thread,
+//  at the rate configured for the device.
 class HardwareOutputDevice
 {
 public:
@@ -12,11 +15,34 @@ public:
 
     virtual bool configure(std::unordered_map<string, string> settings) = 0;
 
-    //Set a hardware channel output. Value is 0.0 to 1.0 for no to max output.
-    virtual void setChannelData(int channel, float value) = 0;
+    //Send a full frame of channel values to the hardware, getChannelCount() values from 0.0 to 1.0 for no to max output.
+    //  Called from the hardware I/O thread, never at the same time for the same device.
+    virtual void sendFrame(const float* channels) = 0;
 
     //Return the number of output channels supported by this device.
     virtual int getChannelCount() = 0;
+
+    //Devices that wait on slow I/O (like HTTP requests) get an I/O thread of their own, so they do not delay the others.
+    virtual bool isBlocking() { return false; }
+
+    //Time between two frames, in seconds.
+    float getFrameInterval() { return frame_interval; }
+    //Time after which an unchanged frame is sent again, in seconds. Negative to never resend an unchanged frame.
+    float getKeepAliveInterval() { return keep_alive_interval; }
+protected:
+    //Read the generic rate settings of a device:
+    // Parameter: "resend_delay" Time between frames, in ms.
+    // Parameter: "keep_alive" Time after which an unchanged frame is sent again, in ms. -1 to never resend.
+    void configureRates(std::unordered_map<string, string>& settings)
+    {
+        if (settings.find("resend_delay") != settings.end())
+            frame_interval = std::max(1, settings["resend_delay"].toInt()) / 1000.0f;
+        if (settings.find("keep_alive") != settings.end())
+            keep_alive_interval = settings["keep_alive"].toInt() / 1000.0f;
+    }
+
+    float frame_interval = 0.05f;
+    float keep_alive_interval = 1.0f;
 };
 
 #endif//HARDWARE_OUTPUT_DEVICE_H
@@ -0,0 +1,47 @@
+#ifndef HARDWARE_VARIABLE_H
+#define HARDWARE_VARIABLE_H
+
+//Variable from hardware.ini, resolved from its name once when the configuration is loaded,
+//  so evaluating it every frame does not need any string compares.
+class HardwareVariable
+{
+public:
+    enum class Type
+    {
+        Unknown,
+        Always,
+        HasShip,
+        Hull,
+        Shield,
+        Energy,
+        ShieldsUp,
+        ShieldsCalibrating,
+        Impulse,
+        Warp,
+        Docking,
+        Docked,
+        InNebula,
+        IsJammed,
+        Jumping,
+        Jumped,
+        Alert,
+        YellowAlert,
+        RedAlert,
+        SelfDestruct,
+        SelfDestructCountdown,
+        TubeLoaded,
+        TubeLoading,
+        TubeUnloading,
+        TubeFiring,
+        SystemHealth,
+        SystemPower,
+        SystemHeat,
+        SystemCoolant,
+        SystemHacked,
+    };
+
+    Type type = Type::Unknown;
+    int index = 0; //Shield, tube or ShipSystem::Type, depending on the type.
+};
+
+#endif//HARDWARE_VARIABLE_H
@@ -61,6 +61,7 @@
 #include "systems/scanning.h"
 #include "systems/radar.h"
 #include "systems/radarblock.h"
+#include "systems/radarvisibility.h"
 #include "systems/zone.h"
 #include "systems/player.h"
 
@@ -153,6 +154,7 @@ void initSystemsAndComponents()
     engine->registerSystem<ScanningSystem>();
     engine->registerSystem<BasicRadarRendering>();
     engine->registerSystem<RadarBlockSystem>();
+    engine->registerSystem<RadarVisibilitySystem>();
     engine->registerSystem<ZoneSystem>();
     engine->registerSystem<PlayerRadarRender>();
     initComponentScriptBindings();
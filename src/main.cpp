@@ -12,6 +12,7 @@
 #endif
 #include <sys/types.h>
 #include "textureManager.h"
+#include "textureStreamer.h"
 #include "soundManager.h"
 #include "gui/theme.h"
 #include "menus/mainMenus.h"
@@ -150,6 +151,8 @@ int main(int argc, char** argv)
     {
         if (!createDisplayWindows())
             return 1;
+        new TextureStreamer();
+        textureStreamer->setUploadBudget(PreferencesManager::get("texture_upload_budget_kb", "4096").toInt() * 1024);
     } else {
         new StdinLuaConsole();
     }
@@ -74,7 +74,7 @@ void LuaConsole::addLog(const string& message)
     if (!console->is_open) {
         console->message_show_timers.emplace_back();
         console->message_show_timers.back().start(5.0f);
-        console->top->layout.size.y = std::min(450.0f, 15.0f + console->message_show_timers.size() * 15.0f);
+        console->top->setSize(console->top->getSize().x, std::min(450.0f, 15.0f + console->message_show_timers.size() * 15.0f));
         console->top->show();
     }
 }
@@ -88,7 +88,7 @@ void LuaConsole::update(float delta)
             entry->hide();
         } else {
             is_open = true;
-            top->layout.size.y = 450;
+            top->setSize(top->getSize().x, 450);
             message_show_timers.clear();
             top->show();
             entry->show();
@@ -99,7 +99,7 @@ void LuaConsole::update(float delta)
         if (message_show_timers.empty()) {
             top->hide();
         } else {
-            top->layout.size.y = std::min(450.0f, 15.0f + message_show_timers.size() * 15.0f);
+            top->setSize(top->getSize().x, std::min(450.0f, 15.0f + message_show_timers.size() * 15.0f));
         }
     }
 }
@@ -7,6 +7,7 @@
 #include "resources.h"
 #include "random.h"
 #include "mesh.h"
+#include "packFormat.h"
 
 namespace
 {
@@ -53,19 +54,34 @@ Mesh::Mesh(std::vector<MeshVertex>&& unindexed_vertices)
             }
         }
 
-        glBindBuffer(GL_ARRAY_BUFFER, vbo_ibo[0]);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(MeshVertex) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
-        glBindBuffer(GL_ARRAY_BUFFER, GL_NONE);
+        uploadBuffers();
+    }
+}
 
-        if (!indices.empty())
-        {
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vbo_ibo[1]);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_count * sizeof(uint16_t), indices.data(), GL_STATIC_DRAW);
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_NONE);
-        }
+Mesh::Mesh(std::vector<MeshVertex>&& vertices, std::vector<uint16_t>&& indices)
+    :vertices{ std::move(vertices) }, indices{ std::move(indices) }, face_count{ static_cast<uint32_t>(this->indices.size()) / 3 }
+{
+    if (!this->vertices.empty() && !this->indices.empty())
+    {
+        vbo_ibo = gl::Buffers<2>{};
+        uploadBuffers();
+    }
+}
+
+void Mesh::uploadBuffers()
+{
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_ibo[0]);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(MeshVertex) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, GL_NONE);
 
-        greatest_distance_from_center = greatestDistanceFromCenter(vertices);
+    if (!indices.empty())
+    {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vbo_ibo[1]);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, face_count * 3 * sizeof(uint16_t), indices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_NONE);
     }
+
+    greatest_distance_from_center = greatestDistanceFromCenter(vertices);
 }
 
 void Mesh::render(int32_t position_attrib, int32_t texcoords_attrib, int32_t normal_attrib)
@@ -296,8 +312,30 @@ Mesh* Mesh::getMesh(const string& filename)
 
     }else if (filename.endswith(".model"))
     {
-        mesh_vertices.resize(readInt(stream));
-        stream->read(mesh_vertices.data(), sizeof(MeshVertex) * mesh_vertices.size());
+        int32_t count = readInt(stream);
+        if (count == pack::indexed_model_marker)
+        {
+            // Pre-indexed model written by pack_builder.
+            std::vector<MeshVertex> indexed_vertices(std::max(readInt(stream), 0));
+            std::vector<uint16_t> indices(std::max(readInt(stream), 0));
+            stream->read(indexed_vertices.data(), sizeof(MeshVertex) * indexed_vertices.size());
+            stream->read(indices.data(), sizeof(uint16_t) * indices.size());
+            bool valid = !indices.empty() && indices.size() % 3 == 0;
+            for(auto index : indices)
+                valid = valid && index < indexed_vertices.size();
+            if (valid)
+            {
+                ret = new Mesh(std::move(indexed_vertices), std::move(indices));
+                meshMap[filename] = ret;
+                return ret;
+            }
+            LOG(ERROR) << "Corrupt indexed model: " << filename;
+        }
+        else
+        {
+            mesh_vertices.resize(std::max(count, 0));
+            stream->read(mesh_vertices.data(), sizeof(MeshVertex) * mesh_vertices.size());
+        }
     }else{
         LOG(ERROR) << "Unknown mesh format: " << filename;
     }
@@ -20,9 +20,13 @@ class Mesh : sp::NonCopyable
     std::vector<uint16_t> indices;
     gl::Buffers<2> vbo_ibo{ gl::Unitialized{} };
     uint32_t face_count{};
+
+    void uploadBuffers();
 public:
     float greatest_distance_from_center{};
     explicit Mesh(std::vector<MeshVertex>&& vertices);
+    // Construct from already indexed data (pre-indexed .model files), skips the vertex remapping.
+    Mesh(std::vector<MeshVertex>&& vertices, std::vector<uint16_t>&& indices);
 
     void render(int32_t position_attrib, int32_t texcoords_attrib, int32_t normal_attrib);
     glm::vec3 randomPoint();
@@ -3,16 +3,22 @@
 
 MissileWeaponData missile_data[MW_Count] =
 {
-    //                speed, turnrate, lifetime, color, homing_range
-    MissileWeaponData(200.0f, 10.f, 27.0f, glm::u8vec4(255, 200, 0, 255), 1200.0, "sfx/rlaunch.wav"),/*MW_Homing*/
-    MissileWeaponData(200.0f, 10.f, 27.0f, glm::u8vec4(255, 100, 32, 255), 500.0, "sfx/rlaunch.wav"),/*MW_Nuke*/
-    MissileWeaponData(100.0f,  0.f, 10.0f, glm::u8vec4(255, 255, 255, 255), 0.0, "sfx/missile_launch.wav"),/*MW_Mine, lifetime is used at time which the mine is ejecting from the ship*/
-    MissileWeaponData(200.0f, 10.f, 27.0f, glm::u8vec4(100, 32, 255, 255), 500.0, "sfx/rlaunch.wav"),/*MW_EMP*/
-    MissileWeaponData(500.0f,  0.f, 13.5f, glm::u8vec4(200, 200, 200, 255), 0.0, "sfx/hvli_fire.wav"),/*MW_HVLI*/
+    //                speed, turnrate, lifetime, color, homing_range, fire_sound,
+    //                  {delayed, center, edge, range, damage type, explosion sfx, radar signature, timeout, avoid delay/range, radar icon}
+    MissileWeaponData(200.0f, 10.f, 27.0f, glm::u8vec4(255, 200, 0, 255), 1200.0, "sfx/rlaunch.wav",
+        {false, 35.0f, 5.0f, 30.0f, DamageType::Kinetic, "", {0.0f, 0.1f, 0.2f}, false, 0.0f, 0.0f, "radar/missile.png"}),/*MW_Homing*/
+    MissileWeaponData(200.0f, 10.f, 27.0f, glm::u8vec4(255, 100, 32, 255), 500.0, "sfx/rlaunch.wav",
+        {false, 160.0f, 30.0f, 1000.0f, DamageType::Kinetic, "sfx/nuke_explosion.wav", {0.0f, 0.7f, 0.1f}, true, 10.0f, 1000.0f, "radar/missile.png"}),/*MW_Nuke*/
+    MissileWeaponData(100.0f,  0.f, 10.0f, glm::u8vec4(255, 255, 255, 255), 0.0, "sfx/missile_launch.wav",
+        {true, 160.0f, 30.0f, 1000.0f, DamageType::Kinetic, "", {0.0f, 0.05f, 0.0f}, false, 0.0f, 0.0f, "radar/mine.png"}),/*MW_Mine, lifetime is used at time which the mine is ejecting from the ship*/
+    MissileWeaponData(200.0f, 10.f, 27.0f, glm::u8vec4(100, 32, 255, 255), 500.0, "sfx/rlaunch.wav",
+        {false, 160.0f, 30.0f, 1000.0f, DamageType::EMP, "", {0.0f, 1.0f, 0.0f}, true, 0.0f, 0.0f, "radar/missile.png"}),/*MW_EMP*/
+    MissileWeaponData(500.0f,  0.f, 13.5f, glm::u8vec4(200, 200, 200, 255), 0.0, "sfx/hvli_fire.wav",
+        {false, 10.0f, 10.0f, 20.0f, DamageType::Kinetic, "", {0.1f, 0.0f, 0.0f}, false, 0.0f, 0.0f, "radar/missile.png"}),/*MW_HVLI*/
 };
 
-MissileWeaponData::MissileWeaponData(float speed, float turnrate, float lifetime, glm::u8vec4 color, float homing_range, string fire_sound)
-: speed(speed), turnrate(turnrate), lifetime(lifetime), color(color), homing_range(homing_range), fire_sound(fire_sound)
+MissileWeaponData::MissileWeaponData(float speed, float turnrate, float lifetime, glm::u8vec4 color, float homing_range, string fire_sound, Projectile projectile)
+: speed(speed), turnrate(turnrate), lifetime(lifetime), color(color), homing_range(homing_range), fire_sound(fire_sound), projectile(projectile)
 {
 }
 
@@ -23,6 +29,13 @@ const MissileWeaponData& MissileWeaponData::getDataFor(EMissileWeapons type)
     return missile_data[type];
 }
 
+void MissileWeaponData::setProjectileFor(EMissileWeapons type, const Projectile& projectile)
+{
+    if (type < 0 || type >= MW_Count)
+        return;
+    missile_data[type].projectile = projectile;
+}
+
 string getMissileSizeString(EMissileSizes size)
 {
     switch (size)
@@ -2,6 +2,8 @@
 #define MISSILE_WEAPON_DATA_H
 
 #include "multiplayer.h"
+#include "systems/damage.h"
+#include <glm/vec3.hpp>
 
 
 enum EMissileWeapons
@@ -29,7 +31,24 @@ string getLocaleMissileWeaponName(EMissileWeapons missile);
 class MissileWeaponData
 {
 public:
-    MissileWeaponData(float speed, float turnrate, float lifetime, glm::u8vec4 color, float homing_range, string fire_sound);
+    //Everything that differs between the projectiles of the missile types, besides the flight data.
+    //  Damage and blast range are for a medium sized missile and scale with the category modifier of the tube.
+    struct Projectile
+    {
+        bool delayed_explode; //Mines explode on touch after a delay, instead of on direct impact.
+        float damage_at_center;
+        float damage_at_edge;
+        float blast_range;
+        DamageType damage_type;
+        string explosion_sfx;
+        glm::vec3 radar_signature; //gravity, electrical, biological
+        bool explode_on_timeout;
+        float avoid_delay; //Delay and range of DelayedAvoidObject, no avoidance when range is zero.
+        float avoid_range;
+        string radar_icon;
+    };
+
+    MissileWeaponData(float speed, float turnrate, float lifetime, glm::u8vec4 color, float homing_range, string fire_sound, Projectile projectile);
 
     float speed; //meter/sec
     float turnrate; //deg/sec
@@ -40,7 +59,11 @@ public:
 
     string fire_sound;
 
+    Projectile projectile;
+
     static const MissileWeaponData& getDataFor(EMissileWeapons type);
+    //Replace the projectile values of a missile type, used by scripts to define their own missile behaviour.
+    static void setProjectileFor(EMissileWeapons type, const Projectile& projectile);
 
     static float convertSizeToCategoryModifier(EMissileSizes size);
     static EMissileSizes convertCategoryModifierToSize(float size);
@@ -0,0 +1,206 @@
+#include "packFormat.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace pack
+{
+
+uint16_t readU16(const uint8_t* data)
+{
+    return uint16_t(data[0]) << 8 | uint16_t(data[1]);
+}
+
+uint32_t readU32(const uint8_t* data)
+{
+    return uint32_t(data[0]) << 24 | uint32_t(data[1]) << 16 | uint32_t(data[2]) << 8 | uint32_t(data[3]);
+}
+
+uint64_t readU64(const uint8_t* data)
+{
+    return uint64_t(readU32(data)) << 32 | uint64_t(readU32(data + 4));
+}
+
+void writeU16(uint8_t* data, uint16_t value)
+{
+    data[0] = uint8_t(value >> 8);
+    data[1] = uint8_t(value);
+}
+
+void writeU32(uint8_t* data, uint32_t value)
+{
+    data[0] = uint8_t(value >> 24);
+    data[1] = uint8_t(value >> 16);
+    data[2] = uint8_t(value >> 8);
+    data[3] = uint8_t(value);
+}
+
+void writeU64(uint8_t* data, uint64_t value)
+{
+    writeU32(data, uint32_t(value >> 32));
+    writeU32(data + 4, uint32_t(value));
+}
+
+void EntryRecord::read(const uint8_t* data)
+{
+    name_offset = readU32(data);
+    name_length = readU16(data + 4);
+    compression = Compression(data[6]);
+    reserved = data[7];
+    position = readU32(data + 8);
+    stored_size = readU32(data + 12);
+    size = readU32(data + 16);
+    content_hash = readU64(data + 20);
+    //Bytes 28-31 are padding.
+}
+
+void EntryRecord::write(uint8_t* data) const
+{
+    memset(data, 0, entry_record_size);
+    writeU32(data, name_offset);
+    writeU16(data + 4, name_length);
+    data[6] = uint8_t(compression);
+    data[7] = reserved;
+    writeU32(data + 8, position);
+    writeU32(data + 12, stored_size);
+    writeU32(data + 16, size);
+    writeU64(data + 20, content_hash);
+}
+
+uint64_t contentHash(const void* data, size_t size)
+{
+    const uint8_t* ptr = static_cast<const uint8_t*>(data);
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for(size_t n=0; n<size; n++)
+    {
+        hash ^= ptr[n];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static void writeLZ4Length(std::vector<uint8_t>& out, size_t length)
+{
+    while(length >= 255)
+    {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(uint8_t(length));
+}
+
+static bool readLZ4Length(const uint8_t*& ip, const uint8_t* iend, size_t& length)
+{
+    uint8_t b;
+    do
+    {
+        if (ip >= iend)
+            return false;
+        b = *ip++;
+        length += b;
+    } while(b == 255);
+    return true;
+}
+
+std::vector<uint8_t> lz4Compress(const uint8_t* src, size_t size)
+{
+    //Greedy single-probe compressor. Output is valid LZ4 block data, but does not try to match the reference compression ratio.
+    constexpr int hash_bits = 14;
+    constexpr uint32_t no_position = 0xFFFFFFFF;
+    constexpr size_t min_match = 4;
+    //The LZ4 block format requires the last 5 bytes to be literals, and the last match to start 12 bytes before the end.
+    constexpr size_t last_literals = 5;
+    constexpr size_t match_start_limit = 12;
+
+    std::vector<uint8_t> out;
+    out.reserve(size + size / 255 + 16);
+    std::vector<uint32_t> table(size_t(1) << hash_bits, no_position);
+
+    size_t anchor = 0;
+    size_t pos = 0;
+    const size_t match_limit = size > match_start_limit ? size - match_start_limit : 0;
+    while(pos < match_limit)
+    {
+        uint32_t sequence;
+        memcpy(&sequence, src + pos, sizeof(sequence));
+        uint32_t hash = (sequence * 2654435761U) >> (32 - hash_bits);
+        uint32_t candidate = table[hash];
+        table[hash] = uint32_t(pos);
+        if (candidate == no_position || pos - candidate > 0xFFFF || memcmp(src + candidate, src + pos, min_match) != 0)
+        {
+            pos++;
+            continue;
+        }
+
+        size_t match_end = pos + min_match;
+        while(match_end < size - last_literals && src[match_end] == src[candidate + (match_end - pos)])
+            match_end++;
+
+        size_t literal_length = pos - anchor;
+        size_t match_length = match_end - pos - min_match;
+        out.push_back(uint8_t(std::min<size_t>(literal_length, 15) << 4 | std::min<size_t>(match_length, 15)));
+        if (literal_length >= 15)
+            writeLZ4Length(out, literal_length - 15);
+        out.insert(out.end(), src + anchor, src + pos);
+        size_t offset = pos - candidate;
+        out.push_back(uint8_t(offset));
+        out.push_back(uint8_t(offset >> 8));
+        if (match_length >= 15)
+            writeLZ4Length(out, match_length - 15);
+
+        pos = anchor = match_end;
+    }
+
+    size_t literal_length = size - anchor;
+    out.push_back(uint8_t(std::min<size_t>(literal_length, 15) << 4));
+    if (literal_length >= 15)
+        writeLZ4Length(out, literal_length - 15);
+    out.insert(out.end(), src + anchor, src + size);
+    return out;
+}
+
+bool lz4Decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size)
+{
+    const uint8_t* ip = src;
+    const uint8_t* iend = src + src_size;
+    uint8_t* op = dst;
+    uint8_t* oend = dst + dst_size;
+
+    while(ip < iend)
+    {
+        uint8_t token = *ip++;
+        size_t literal_length = token >> 4;
+        if (literal_length == 15 && !readLZ4Length(ip, iend, literal_length))
+            return false;
+        if (size_t(iend - ip) < literal_length || size_t(oend - op) < literal_length)
+            return false;
+        if (literal_length > 0)
+            memcpy(op, ip, literal_length);
+        op += literal_length;
+        ip += literal_length;
+        //The last sequence only has literals.
+        if (ip == iend)
+            break;
+
+        if (iend - ip < 2)
+            return false;
+        size_t offset = size_t(ip[0]) | size_t(ip[1]) << 8;
+        ip += 2;
+        if (offset == 0 || offset > size_t(op - dst))
+            return false;
+        size_t match_length = token & 15;
+        if (match_length == 15 && !readLZ4Length(ip, iend, match_length))
+            return false;
+        match_length += 4;
+        if (size_t(oend - op) < match_length)
+            return false;
+        //Matches can overlap with the output they produce, so copy byte by byte.
+        const uint8_t* match = op - offset;
+        for(size_t n=0; n<match_length; n++)
+            op[n] = match[n];
+        op += match_length;
+    }
+    return op == oend;
+}
+
+}//namespace pack
@@ -0,0 +1,74 @@
+#ifndef PACK_FORMAT_H
+#define PACK_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//Shared definitions of the .pack file format, used by both the PackResourceProvider and the pack_builder tool.
+//  This file does not depend on SeriousProton, so the tool can be built without the engine.
+//
+//Version 0:
+//  int32 version, int32 file_count
+//  file_count * (int8 name_length, name, int32 position, int32 size)
+//  uncompressed file data
+//
+//Version 1:
+//  int32 version, int32 file_count, int32 hash_slot_count (power of 2)
+//  file_count * 32 byte entry records (see EntryRecord), sorted on name
+//  hash_slot_count * uint32 lookup slots (entry index + 1, 0 for an empty slot), keyed on nameHash()
+//  name table (the names referenced by the entry records, not zero terminated)
+//  file data, optionally LZ4 block compressed per entry
+//
+//All integers in the pack headers are big endian.
+namespace pack
+{
+    constexpr int32_t format_version_0 = 0;
+    constexpr int32_t format_version_1 = 1;
+
+    enum class Compression : uint8_t
+    {
+        None = 0,
+        LZ4 = 1,
+    };
+
+    constexpr size_t header_size_v1 = 12;
+    constexpr size_t entry_record_size = 32;
+
+    struct EntryRecord
+    {
+        uint32_t name_offset;   //Relative to the start of the name table.
+        uint16_t name_length;
+        Compression compression;
+        uint8_t reserved;
+        uint32_t position;      //Absolute position in the pack file.
+        uint32_t stored_size;   //Size in the pack file.
+        uint32_t size;          //Size after decompression.
+        uint64_t content_hash;  //contentHash() of the uncompressed data.
+
+        void read(const uint8_t* data);
+        void write(uint8_t* data) const;
+    };
+
+    //Pre-indexed models are stored as .model files that start with this marker instead of a vertex count:
+    //  int32 marker, int32 vertex_count, int32 index_count, vertex data, uint16 indices
+    constexpr int32_t indexed_model_marker = -1;
+
+    uint16_t readU16(const uint8_t* data);
+    uint32_t readU32(const uint8_t* data);
+    uint64_t readU64(const uint8_t* data);
+    void writeU16(uint8_t* data, uint16_t value);
+    void writeU32(uint8_t* data, uint32_t value);
+    void writeU64(uint8_t* data, uint64_t value);
+
+    //64 bit FNV-1a
+    uint64_t contentHash(const void* data, size_t size);
+    inline uint32_t nameHash(const void* data, size_t size) { return uint32_t(contentHash(data, size)); }
+
+    //LZ4 block format (no frame header). Decompression fails on any malformed input,
+    //  or when the output does not exactly fill dst_size.
+    std::vector<uint8_t> lz4Compress(const uint8_t* src, size_t size);
+    bool lz4Decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size);
+}
+
+#endif//PACK_FORMAT_H
@@ -1,14 +1,10 @@
 #include "packResourceProvider.h"
 
-#include <cstdio>
+#include <algorithm>
+#include <cstring>
 #include <SDL_endian.h>
 #include <SDL_rwops.h>
-
-#ifdef _WIN32
-#include <malloc.h>
-#else
-#include <alloca.h>
-#endif
+#include <SDL_stdinc.h>
 
 #ifdef ANDROID
 #include <jni.h>
@@ -19,64 +15,325 @@
 #include <filesystem>
 #endif
 
-static inline int readInt(SDL_RWops* f)
+#ifdef _WIN32
+#include <windows.h>
+#elif !defined(ANDROID)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+PackFileMapping::~PackFileMapping()
 {
-    int32_t ret = 0;
-    SDL_RWread(f, &ret, sizeof(int32_t), 1);
-    return SDL_SwapBE32(ret);
+    close();
 }
 
-static inline string readString(SDL_RWops *f)
+bool PackFileMapping::open(const string& filename)
 {
-    int8_t len = 0;
-    SDL_RWread(f, &len, sizeof(int8_t), 1);
-    // MFC - MSVC doesn't support non-const [] initializers
-    char *buffer = (char*)alloca(len + 1);
-    SDL_RWread(f, buffer, len, 1);
-    buffer[len] = '\0';
-    return string(buffer);
+    close();
+#if defined(_WIN32)
+    int wlen = MultiByteToWideChar(CP_UTF8, 0, filename.c_str(), -1, nullptr, 0);
+    std::vector<wchar_t> wfilename(wlen);
+    MultiByteToWideChar(CP_UTF8, 0, filename.c_str(), -1, wfilename.data(), wlen);
+    HANDLE file = CreateFileW(wfilename.data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER file_size;
+        HANDLE mapping = nullptr;
+        if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+            mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (view)
+        {
+            file_handle = file;
+            mapping_handle = mapping;
+            ptr = static_cast<const uint8_t*>(view);
+            length = size_t(file_size.QuadPart);
+            mapped = true;
+            return true;
+        }
+        if (mapping)
+            CloseHandle(mapping);
+        CloseHandle(file);
+    }
+#elif !defined(ANDROID)
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void* view = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED)
+            {
+                //The mapping stays valid after closing the descriptor.
+                ::close(fd);
+                ptr = static_cast<const uint8_t*>(view);
+                length = size_t(st.st_size);
+                mapped = true;
+                return true;
+            }
+        }
+        ::close(fd);
+    }
+#endif
+    //Fallback: read the whole file into memory once. Used for Android assets, which cannot be mapped as regular files.
+    auto f = SDL_RWFromFile(filename.c_str(), "rb");
+    if (!f)
+        return false;
+    size_t data_size = 0;
+    void* buffer = SDL_LoadFile_RW(f, &data_size, 1);
+    if (!buffer)
+        return false;
+    ptr = static_cast<const uint8_t*>(buffer);
+    length = data_size;
+    mapped = false;
+    return true;
 }
 
+void PackFileMapping::close()
+{
+    if (!ptr)
+        return;
+    if (mapped)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(ptr);
+        CloseHandle(mapping_handle);
+        CloseHandle(file_handle);
+        mapping_handle = nullptr;
+        file_handle = nullptr;
+#elif !defined(ANDROID)
+        munmap(const_cast<uint8_t*>(ptr), length);
+#endif
+    }
+    else
+    {
+        SDL_free(const_cast<uint8_t*>(ptr));
+    }
+    ptr = nullptr;
+    length = 0;
+    mapped = false;
+}
+
+//Reads big endian values from the mapped index, with bounds checking.
+class PackIndexReader
+{
+public:
+    PackIndexReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    bool readInt(int32_t& value)
+    {
+        if (position + sizeof(int32_t) > size)
+            return false;
+        int32_t ret;
+        memcpy(&ret, data + position, sizeof(int32_t));
+        position += sizeof(int32_t);
+        value = SDL_SwapBE32(ret);
+        return true;
+    }
+
+    bool readString(string& value)
+    {
+        if (position + 1 > size)
+            return false;
+        size_t len = uint8_t(data[position]);
+        position += 1;
+        if (position + len > size)
+            return false;
+        value = std::string(reinterpret_cast<const char*>(data + position), len);
+        position += len;
+        return true;
+    }
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t position = 0;
+};
+
 PackResourceProvider::PackResourceProvider(string filename)
 : filename(filename)
 {
-    auto f = SDL_RWFromFile(filename.c_str(), "rb");
-    if (!f)
+    if (!mapping.open(filename))
     {
         LOG(WARNING) << "Failed to open " << filename << ": " << SDL_GetError();
         return;
     }
 
-    int version = readInt(f);
-    if (version == 0)
+    PackIndexReader reader(mapping.data(), mapping.size());
+    int32_t version = -1;
+    reader.readInt(version);
+    if (version == pack::format_version_0)
+        loadVersion0();
+    else if (version == pack::format_version_1)
+        loadVersion1();
+    else
+        LOG(WARNING) << filename << " has unknown version " << version;
+}
+
+void PackResourceProvider::loadVersion0()
+{
+    PackIndexReader reader(mapping.data(), mapping.size());
+    int32_t version, file_count = 0;
+    reader.readInt(version);
+    reader.readInt(file_count);
+    files.reserve(std::max(file_count, 0));
+    for(int n=0; n<file_count; n++)
+    {
+        string name;
+        int32_t position, size;
+        if (!reader.readString(name) || !reader.readInt(position) || !reader.readInt(size))
+        {
+            LOG(WARNING) << filename << " has a truncated index";
+            break;
+        }
+        if (position < 0 || size < 0 || size_t(position) + size_t(size) > mapping.size())
+        {
+            LOG(WARNING) << filename << ": entry " << name << " is out of bounds, skipping";
+            continue;
+        }
+        files.emplace_back(name, PackResourceInfo(position, size));
+    }
+    std::sort(files.begin(), files.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    LOG(INFO) << "Loaded: " << filename << " with " << files.size() << " files";
+}
+
+void PackResourceProvider::loadVersion1()
+{
+    const uint8_t* data = mapping.data();
+    size_t data_size = mapping.size();
+    if (data_size < pack::header_size_v1)
+    {
+        LOG(WARNING) << filename << " has a truncated header";
+        return;
+    }
+    uint32_t file_count = pack::readU32(data + 4);
+    uint32_t slot_count = pack::readU32(data + 8);
+    size_t entries_offset = pack::header_size_v1;
+    size_t slots_offset = entries_offset + size_t(file_count) * pack::entry_record_size;
+    size_t names_offset = slots_offset + size_t(slot_count) * sizeof(uint32_t);
+    if (names_offset > data_size || (slot_count & (slot_count - 1)) != 0)
+    {
+        LOG(WARNING) << filename << " has a corrupt index";
+        return;
+    }
+
+    bool index_intact = true;
+    files.reserve(file_count);
+    for(uint32_t n=0; n<file_count; n++)
     {
-        int file_count = readInt(f);
-        LOG(INFO) << "Loaded: " << filename << " with " << file_count << " files";
-        for(int n=0; n<file_count; n++)
+        pack::EntryRecord record;
+        record.read(data + entries_offset + n * pack::entry_record_size);
+        size_t name_position = names_offset + record.name_offset;
+        if (name_position + record.name_length > data_size || size_t(record.position) + size_t(record.stored_size) > data_size)
+        {
+            LOG(WARNING) << filename << ": entry " << n << " is out of bounds, skipping";
+            index_intact = false;
+            continue;
+        }
+        if (record.compression != pack::Compression::None && record.compression != pack::Compression::LZ4)
         {
-            string fileName = readString(f);
-            int position = readInt(f);
-            int size = readInt(f);
-            files[fileName] = PackResourceInfo(position, size);
+            LOG(WARNING) << filename << ": entry " << n << " uses unknown compression " << int(record.compression) << ", skipping";
+            index_intact = false;
+            continue;
         }
+        PackResourceInfo info(record.position, record.size);
+        info.stored_size = record.stored_size;
+        info.compression = record.compression;
+        info.has_content_hash = true;
+        info.content_hash = record.content_hash;
+        files.emplace_back(std::string(reinterpret_cast<const char*>(data + name_position), record.name_length), info);
     }
-    else
+
+    //The builder writes the entries sorted, so the lookup table indices match our list.
+    //  If that is not the case (or entries were skipped) fall back to binary searching.
+    auto less = [](const auto& a, const auto& b) { return a.first < b.first; };
+    if (!std::is_sorted(files.begin(), files.end(), less))
     {
-        LOG(WARNING) << filename << " has unknown version " << version;
+        std::sort(files.begin(), files.end(), less);
+        index_intact = false;
+    }
+    if (index_intact && slot_count > 0)
+    {
+        hash_slots = data + slots_offset;
+        hash_slot_count = slot_count;
     }
-    SDL_RWclose(f);
+    LOG(INFO) << "Loaded: " << filename << " with " << files.size() << " files";
+}
+
+PackResourceInfo* PackResourceProvider::find(const string& name)
+{
+    if (hash_slots)
+    {
+        //Open addressing with linear probing, an empty slot ends the search.
+        uint32_t mask = hash_slot_count - 1;
+        uint32_t slot = pack::nameHash(name.data(), name.size()) & mask;
+        for(uint32_t probe=0; probe<hash_slot_count; probe++, slot = (slot + 1) & mask)
+        {
+            uint32_t index = pack::readU32(hash_slots + slot * sizeof(uint32_t));
+            if (index == 0 || index > files.size())
+                return nullptr;
+            if (files[index - 1].first == name)
+                return &files[index - 1].second;
+        }
+        return nullptr;
+    }
+    auto it = std::lower_bound(files.begin(), files.end(), name, [](const auto& entry, const string& key) { return entry.first < key; });
+    if (it != files.end() && it->first == name)
+        return &it->second;
+    return nullptr;
 }
 
 P<ResourceStream> PackResourceProvider::getResourceStream(const string filename)
 {
-    if (files.find(filename) != files.end())
-        return new PackResourceStream(this->filename, files.find(filename)->second);
-    return NULL;
+    auto info = find(filename);
+    if (!info)
+        return NULL;
+    const uint8_t* stored = mapping.data() + info->position;
+    if (info->compression == pack::Compression::LZ4)
+    {
+        std::vector<uint8_t> buffer(info->size);
+        if (!pack::lz4Decompress(stored, info->stored_size, buffer.data(), buffer.size()))
+        {
+            LOG(ERROR) << this->filename << ": failed to decompress " << filename;
+            return NULL;
+        }
+        if (info->has_content_hash && !info->content_verified)
+        {
+            if (pack::contentHash(buffer.data(), buffer.size()) != info->content_hash)
+            {
+                LOG(ERROR) << this->filename << ": checksum mismatch for " << filename;
+                return NULL;
+            }
+            info->content_verified = true;
+        }
+        return new PackResourceStream(std::move(buffer));
+    }
+    if (info->has_content_hash && !info->content_verified)
+    {
+        if (pack::contentHash(stored, info->size) != info->content_hash)
+        {
+            LOG(ERROR) << this->filename << ": checksum mismatch for " << filename;
+            return NULL;
+        }
+        info->content_verified = true;
+    }
+    return new PackResourceStream(stored, info->size);
 }
 
 std::vector<string> PackResourceProvider::findResources(const string searchPattern)
 {
     std::vector<string> ret;
+    //Everything in front of the first wildcard is a fixed prefix, which selects a contiguous range of the sorted index.
+    int wildcard = searchPattern.find("*");
+    string prefix = wildcard < 0 ? searchPattern : searchPattern.substr(0, wildcard);
+    auto it = std::lower_bound(files.begin(), files.end(), prefix, [](const auto& entry, const string& key) { return entry.first < key; });
+    for(; it != files.end() && it->first.startswith(prefix); ++it)
+    {
+        if (searchMatch(it->first, searchPattern))
+            ret.push_back(it->first);
+    }
     return ret;
 }
 
@@ -143,34 +400,30 @@ void PackResourceProvider::addPackResourcesForDirectory(const string directory)
 #endif
 }
 
-PackResourceStream::PackResourceStream(string filename, PackResourceInfo info)
-: position(info.position), size(info. size)
+PackResourceStream::PackResourceStream(const uint8_t* data, size_t size)
+: data(data), size(size)
 {
-    f = SDL_RWFromFile(filename.c_str(), "rb");
-    if (!f)
-        destroy();
-    else
-        seek(0);
 }
-PackResourceStream::~PackResourceStream()
+
+PackResourceStream::PackResourceStream(std::vector<uint8_t>&& buffer)
+: buffer(std::move(buffer))
 {
-    if (f)
-        SDL_RWclose(f);
+    data = this->buffer.data();
+    size = this->buffer.size();
 }
 
 size_t PackResourceStream::read(void* data, size_t size)
 {
     if (read_position + size > this->size)
         size = this->size - read_position;
-    auto ret = SDL_RWread(f, data, 1, size);
-    read_position += ret;
-    return ret;
+    memcpy(data, this->data + read_position, size);
+    read_position += size;
+    return size;
 }
 
 size_t PackResourceStream::seek(size_t position)
 {
-    read_position = position;
-    SDL_RWseek(f, this->position + read_position, RW_SEEK_SET);
+    read_position = std::min(position, size);
     return read_position;
 }
 
@@ -2,21 +2,63 @@
 #define PACK_RESOURCE_PROVIDER_H
 
 #include "resources.h"
-#include <unordered_map>
+#include "packFormat.h"
+#include <cstdint>
+#include <vector>
 
 struct PackResourceInfo
 {
     PackResourceInfo() {}
-    PackResourceInfo(size_t position, size_t size) : position(position), size(size) {}
+    PackResourceInfo(size_t position, size_t size) : position(position), size(size), stored_size(size) {}
 
     size_t position;
     size_t size;
+    size_t stored_size;
+    pack::Compression compression = pack::Compression::None;
+    bool has_content_hash = false;
+    uint64_t content_hash = 0;
+    bool content_verified = false; //Set after the first successful hash check, the mapping is read-only so it cannot change afterwards.
+};
+
+//Read-only view of a complete pack file in memory.
+//  Uses mmap/MapViewOfFile where available, and falls back to reading the file into a buffer (Android assets).
+class PackFileMapping
+{
+public:
+    PackFileMapping() {}
+    ~PackFileMapping();
+
+    PackFileMapping(const PackFileMapping&) = delete;
+    PackFileMapping& operator=(const PackFileMapping&) = delete;
+
+    bool open(const string& filename);
+    void close();
+
+    const uint8_t* data() const { return ptr; }
+    size_t size() const { return length; }
+private:
+    const uint8_t* ptr = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+#ifdef _WIN32
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#endif
 };
 
 class PackResourceProvider : public ResourceProvider
 {
     string filename;
-    std::unordered_map<string, PackResourceInfo> files;
+    PackFileMapping mapping;
+    //Sorted on name, so we can do binary searches for both exact matches and prefixes.
+    std::vector<std::pair<string, PackResourceInfo>> files;
+    //Version 1 lookup table, points into the mapping. Slots hold indices into the files list.
+    const uint8_t* hash_slots = nullptr;
+    uint32_t hash_slot_count = 0;
+
+    void loadVersion0();
+    void loadVersion1();
+    PackResourceInfo* find(const string& name);
 public:
     PackResourceProvider(string filename);
 
@@ -26,17 +68,18 @@ public:
     static void addPackResourcesForDirectory(const string directory);
 };
 
+//Stream that reads directly from the memory mapping of the pack file, without copying or extra file handles.
+//  Compressed entries are decompressed into a buffer owned by the stream.
 class PackResourceStream : public ResourceStream
 {
-    struct SDL_RWops* f;
-    size_t position;
+    std::vector<uint8_t> buffer; //Only used for compressed entries, uncompressed entries are read from the mapping directly.
+    const uint8_t* data;
     size_t size;
-    size_t read_position;
+    size_t read_position = 0;
 
-    PackResourceStream(string filename, PackResourceInfo info);
+    PackResourceStream(const uint8_t* data, size_t size);
+    PackResourceStream(std::vector<uint8_t>&& buffer);
 public:
-    virtual ~PackResourceStream();
-
     virtual size_t read(void* data, size_t size) override;
     virtual size_t seek(size_t position) override;
     virtual size_t tell() override;
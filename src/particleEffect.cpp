@@ -4,10 +4,11 @@
 #include "particleEffect.h"
 #include "shaderManager.h"
 #include "textureManager.h"
-#include "tween.h"
 
 #include <SDL_assert.h>
 
+#include <algorithm>
+
 #include <glm/gtx/norm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -29,13 +30,17 @@ void ParticleEngine::render(const glm::mat4& projection, const glm::mat4& view)
 
 void ParticleEngine::update(float delta)
 {
-    // Update particles, move all freshly expired particles to the end.
-    // Update our first_expired entry.
-    first_expired = std::partition(std::begin(particles), first_expired, [delta](Particle& p)
+    time += delta;
+
+    // Retire expired particles from the tail of the ring. Particles that expire while an older one is still alive
+    // stay in the drawn range, the shader collapses them.
+    while(live_count > 0)
     {
-        p.life_time += delta;
-        return p.life_time <= p.max_life_time;
-    });
+        size_t tail = (head + capacity - live_count) % capacity;
+        if (expire_times[tail] > time)
+            break;
+        live_count--;
+    }
 }
 
 void ParticleEngine::spawn(glm::vec3 position, glm::vec3 end_position, glm::vec3 color, glm::vec3 end_color, float size, float end_size, float life_time)
@@ -49,8 +54,15 @@ void ParticleEngine::spawn(glm::vec3 position, glm::vec3 end_position, glm::vec3
     particleEngine->doSpawn(position, end_position, color, end_color, size, end_size, life_time);
 }
 
+size_t ParticleEngine::getLiveParticleCount()
+{
+    if (!particleEngine)
+        return 0;
+    return particleEngine->live_count;
+}
+
 ParticleEngine::ParticleEngine()
-    :first_expired{ std::end(particles) }
+    :vertices(capacity * vertices_per_instance), expire_times(capacity, 0.f)
 {
 }
 
@@ -69,76 +81,89 @@ void ParticleEngine::doRender(const glm::mat4& projection, const glm::mat4& view
     // - Matrices
     glUniformMatrix4fv(uniforms[as_index(Uniforms::Projection)], 1, GL_FALSE, glm::value_ptr(projection));
     glUniformMatrix4fv(uniforms[as_index(Uniforms::View)], 1, GL_FALSE, glm::value_ptr(view));
-    
+    glUniform1f(uniforms[as_index(Uniforms::Time)], time);
+
     {
-        gl::ScopedVertexAttribArray centers(attributes[as_index(Attributes::Center)]);
-        gl::ScopedVertexAttribArray texcoords(attributes[as_index(Attributes::TexCoords)]);
-        gl::ScopedVertexAttribArray colors(attributes[as_index(Attributes::Color)]);
-        gl::ScopedVertexAttribArray sizes(attributes[as_index(Attributes::Size)]);
         gl::ScopedBufferBinding element_buffer(GL_ELEMENT_ARRAY_BUFFER, buffers[as_index(Buffers::Element)]);
-        gl::ScopedBufferBinding vertex_buffer(GL_ARRAY_BUFFER, buffers[as_index(Buffers::Vertex)]);
 
-        glVertexAttribPointer(centers.get(), 3, GL_FLOAT, GL_FALSE, sizeof(ParticleData), reinterpret_cast<const GLvoid *>(offsetof(ParticleData, position)));
-        glVertexAttribPointer(texcoords.get(), 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), reinterpret_cast<const GLvoid*>(max_vertex_count * sizeof(ParticleData)));
-        glVertexAttribPointer(colors.get(), 3, GL_FLOAT, GL_FALSE, sizeof(ParticleData), reinterpret_cast<const GLvoid*>(offsetof(ParticleData, color)));
-        glVertexAttribPointer(sizes.get(), 1, GL_FLOAT, GL_FALSE, sizeof(ParticleData), reinterpret_cast<const GLvoid*>(offsetof(ParticleData, size)));
- 
-        // Process only non-expired
-        size_t live_particle_count = first_expired - std::begin(particles);
+        // Upload the particles spawned since the last frame, in at most two parts when they wrap around.
+        if (dirty_count > 0)
+        {
+            gl::ScopedBufferBinding vertex_buffer(GL_ARRAY_BUFFER, buffers[as_index(Buffers::Vertex)]);
+            auto first_part = std::min(dirty_count, capacity - dirty_first);
+            uploadRange(dirty_first, first_part);
+            uploadRange(0, dirty_count - first_part);
+            dirty_count = 0;
+        }
 
-        for (size_t n = 0U; n < live_particle_count;)
+        std::array<gl::ScopedVertexAttribArray, static_cast<size_t>(Attributes::Count)> enabled_attributes{
+            gl::ScopedVertexAttribArray(attributes[as_index(Attributes::StartCenter)]),
+            gl::ScopedVertexAttribArray(attributes[as_index(Attributes::EndCenter)]),
+            gl::ScopedVertexAttribArray(attributes[as_index(Attributes::StartColor)]),
+            gl::ScopedVertexAttribArray(attributes[as_index(Attributes::EndColor)]),
+            gl::ScopedVertexAttribArray(attributes[as_index(Attributes::Size)]),
+            gl::ScopedVertexAttribArray(attributes[as_index(Attributes::Lifetime)]),
+            gl::ScopedVertexAttribArray(attributes[as_index(Attributes::TexCoords)]),
+        };
+
+        // Texcoords are the same for every quad, so that buffer is shared by all draws.
+        glBindBuffer(GL_ARRAY_BUFFER, buffers[as_index(Buffers::TexCoords)]);
+        glVertexAttribPointer(attributes[as_index(Attributes::TexCoords)], 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), nullptr);
+        glBindBuffer(GL_ARRAY_BUFFER, buffers[as_index(Buffers::Vertex)]);
+
+        // Draw the live range of the ring, which may wrap around.
+        size_t tail = (head + capacity - live_count) % capacity;
+        for (size_t n = 0U; n < live_count;)
         {
-            auto instance_count = std::min(live_particle_count - n, instances_per_draw);
-
-            // setup the instances (individual particles)
-            for (auto instance = 0U; instance < instance_count; ++instance)
-            {
-                const auto& p = particles[n + instance];
-                auto position = Tween<glm::vec3>::easeOutQuad(p.life_time, 0, p.max_life_time, p.start.position, p.end.position);
-                auto color = Tween<glm::vec3>::easeOutQuad(p.life_time, 0, p.max_life_time, p.start.color, p.end.color);
-                auto size = Tween<float>::easeOutQuad(p.life_time, 0, p.max_life_time, p.start.size, p.end.size);
-
-                auto base_vertex = vertices_per_instance * instance;
-                for (auto v = 0U; v < vertices_per_instance; ++v)
-                {
-                    particles_renderdata[base_vertex + v].position = position;
-                    particles_renderdata[base_vertex + v].color = color;
-                    particles_renderdata[base_vertex + v].size = size;
-                }
-            }
-
-            // Send instances to shader.
-            glBufferSubData(GL_ARRAY_BUFFER, 0, instance_count * vertices_per_instance * sizeof(ParticleData), particles_renderdata.data());
-        
-            // Draw our instances
+            size_t first = (tail + n) % capacity;
+            auto instance_count = std::min({live_count - n, instances_per_draw, capacity - first});
+
+            // ES2 has no base vertex for draws, so offset the attribute pointers instead.
+            auto base = reinterpret_cast<const uint8_t*>(first * vertices_per_instance * sizeof(ParticleVertex));
+            glVertexAttribPointer(attributes[as_index(Attributes::StartCenter)], 3, GL_FLOAT, GL_FALSE, sizeof(ParticleVertex), base + offsetof(ParticleVertex, start_position));
+            glVertexAttribPointer(attributes[as_index(Attributes::EndCenter)], 3, GL_FLOAT, GL_FALSE, sizeof(ParticleVertex), base + offsetof(ParticleVertex, end_position));
+            glVertexAttribPointer(attributes[as_index(Attributes::StartColor)], 3, GL_FLOAT, GL_FALSE, sizeof(ParticleVertex), base + offsetof(ParticleVertex, start_color));
+            glVertexAttribPointer(attributes[as_index(Attributes::EndColor)], 3, GL_FLOAT, GL_FALSE, sizeof(ParticleVertex), base + offsetof(ParticleVertex, end_color));
+            glVertexAttribPointer(attributes[as_index(Attributes::Size)], 2, GL_FLOAT, GL_FALSE, sizeof(ParticleVertex), base + offsetof(ParticleVertex, size));
+            glVertexAttribPointer(attributes[as_index(Attributes::Lifetime)], 2, GL_FLOAT, GL_FALSE, sizeof(ParticleVertex), base + offsetof(ParticleVertex, lifetime));
+
             glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(elements_per_instance * instance_count), GL_UNSIGNED_SHORT, nullptr);
-            
+
             n += instance_count;
         }
+        glBindBuffer(GL_ARRAY_BUFFER, GL_NONE);
     }
 }
 
-void ParticleEngine::doSpawn(glm::vec3 position, glm::vec3 end_position, glm::vec3 color, glm::vec3 end_color, float size, float end_size, float life_time)
+void ParticleEngine::uploadRange(size_t first, size_t count)
 {
-    if (first_expired == std::end(particles))
-    {
-        // No expired particles - add more.
-        constexpr size_t batch_size = 64;
-        particles.resize(particles.size() + batch_size);
-        first_expired = std::end(particles) - batch_size;
-    }
+    if (count == 0)
+        return;
+    auto vertex_offset = first * vertices_per_instance;
+    glBufferSubData(GL_ARRAY_BUFFER, vertex_offset * sizeof(ParticleVertex), count * vertices_per_instance * sizeof(ParticleVertex), &vertices[vertex_offset]);
+}
 
-    // Update particle at first_expired.
-    first_expired->start.position = position;
-    first_expired->end.position = end_position;
-    first_expired->start.color = color;
-    first_expired->end.color = end_color;
-    first_expired->start.size = size;
-    first_expired->end.size = end_size;
-    first_expired->life_time = 0.f;
-    first_expired->max_life_time = life_time;
-
-    ++first_expired;
+void ParticleEngine::doSpawn(glm::vec3 position, glm::vec3 end_position, glm::vec3 color, glm::vec3 end_color, float size, float end_size, float life_time)
+{
+    ParticleVertex vertex;
+    vertex.start_position = position;
+    vertex.end_position = end_position;
+    vertex.start_color = color;
+    vertex.end_color = end_color;
+    vertex.size = {size, end_size};
+    vertex.lifetime = {time, life_time};
+    auto base_vertex = head * vertices_per_instance;
+    for (auto v = 0U; v < vertices_per_instance; ++v)
+        vertices[base_vertex + v] = vertex;
+    expire_times[head] = time + life_time;
+
+    if (dirty_count == 0)
+        dirty_first = head;
+    dirty_count = std::min(dirty_count + 1, capacity);
+
+    // When full, the oldest particle is overwritten.
+    live_count = std::min(live_count + 1, capacity);
+    head = (head + 1) % capacity;
 }
 
 void ParticleEngine::initialize()
@@ -151,16 +176,19 @@ void ParticleEngine::initialize()
 
     uniforms[as_index(Uniforms::Projection)] = shader->getUniformLocation("projection");
     uniforms[as_index(Uniforms::View)] = shader->getUniformLocation("view");
+    uniforms[as_index(Uniforms::Time)] = shader->getUniformLocation("time");
 
-    attributes[as_index(Attributes::Center)] = shader->getAttributeLocation("center");
-    attributes[as_index(Attributes::TexCoords)] = shader->getAttributeLocation("texcoords");
-    attributes[as_index(Attributes::Color)] = shader->getAttributeLocation("color");
+    attributes[as_index(Attributes::StartCenter)] = shader->getAttributeLocation("start_center");
+    attributes[as_index(Attributes::EndCenter)] = shader->getAttributeLocation("end_center");
+    attributes[as_index(Attributes::StartColor)] = shader->getAttributeLocation("start_color");
+    attributes[as_index(Attributes::EndColor)] = shader->getAttributeLocation("end_color");
     attributes[as_index(Attributes::Size)] = shader->getAttributeLocation("size");
+    attributes[as_index(Attributes::Lifetime)] = shader->getAttributeLocation("lifetime");
+    attributes[as_index(Attributes::TexCoords)] = shader->getAttributeLocation("texcoords");
 
     std::vector<uint16_t> elements(instances_per_draw * elements_per_instance);
 
     std::vector<glm::vec2> texcoords(max_vertex_count);
-    particles_renderdata.resize(max_vertex_count);
 
     // Hitting this means needing to lower the number of instances / vertices per instance.
     SDL_assert((texcoords.size() - 1) <= std::numeric_limits<uint16_t>::max());
@@ -188,15 +216,15 @@ void ParticleEngine::initialize()
 
     // Hand off to the GPU.
     gl::ScopedBufferBinding element_buffer(GL_ELEMENT_ARRAY_BUFFER, buffers[as_index(Buffers::Element)]);
-    gl::ScopedBufferBinding vertex_buffer(GL_ARRAY_BUFFER, buffers[as_index(Buffers::Vertex)]);
-
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, elements.size() * sizeof(uint16_t), elements.data(), GL_STATIC_DRAW);
-    glBufferData(GL_ARRAY_BUFFER, max_vertex_count * (sizeof(ParticleData) + sizeof(glm::vec2)), nullptr, GL_DYNAMIC_DRAW);
     {
-        // Ensure zero-initialization of the particle data.
-        glBufferSubData(GL_ARRAY_BUFFER, 0, particles_renderdata.size() * sizeof(ParticleData), particles_renderdata.data());
-
-        // Upload texcoords once.
-        glBufferSubData(GL_ARRAY_BUFFER, particles_renderdata.size() * sizeof(ParticleData), texcoords.size() * sizeof(glm::vec2), texcoords.data());
+        gl::ScopedBufferBinding texcoords_buffer(GL_ARRAY_BUFFER, buffers[as_index(Buffers::TexCoords)]);
+        glBufferData(GL_ARRAY_BUFFER, texcoords.size() * sizeof(glm::vec2), texcoords.data(), GL_STATIC_DRAW);
+    }
+    {
+        // The whole ring, including particles spawned before the first render.
+        gl::ScopedBufferBinding vertex_buffer(GL_ARRAY_BUFFER, buffers[as_index(Buffers::Vertex)]);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(ParticleVertex), vertices.data(), GL_DYNAMIC_DRAW);
     }
+    dirty_count = 0;
 }
@@ -6,24 +6,24 @@
 
 #include "glObjects.h"
 
+#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/mat4x4.hpp>
 
-struct ParticleData
+// Per vertex data of a particle, written once when the particle is spawned.
+// The particle shader interpolates between start and end using the time uniform.
+struct ParticleVertex
 {
-    glm::vec3 position{};
-    glm::vec3 color{};
-    float size{};
-};
-class Particle
-{
-public:
-    ParticleData start;
-    ParticleData end;
-    float life_time;
-    float max_life_time;
+    glm::vec3 start_position{};
+    glm::vec3 end_position{};
+    glm::vec3 start_color{};
+    glm::vec3 end_color{};
+    glm::vec2 size{};       // start, end
+    glm::vec2 lifetime{};   // spawn time, duration
 };
 
+// Particles live in a fixed size ring buffer on the GPU. Spawning writes the new particle into the next slot
+// (overwriting the oldest one when full), and only the slots written since the last frame are uploaded.
 class ParticleEngine : public Updatable
 {
     static ParticleEngine* particleEngine;
@@ -32,11 +32,13 @@ class ParticleEngine : public Updatable
     static constexpr size_t elements_per_instance = 6; // ... made of two triangles (ES2 has no support for GL_QUADS)
     static constexpr size_t instances_per_draw = (std::numeric_limits<uint16_t>::max() + 1) / vertices_per_instance; // Number of particles that a single draw can handle.
     static constexpr size_t max_vertex_count = instances_per_draw * vertices_per_instance; // Maximum number of vertices per draw call.
+    static constexpr size_t capacity = instances_per_draw * 2; // Number of particles in the ring buffer.
 
     enum class Uniforms : uint8_t
     {
         Projection = 0,
         View,
+        Time,
 
         Count
     };
@@ -45,16 +47,20 @@ class ParticleEngine : public Updatable
     {
         Element = 0,
         Vertex,
+        TexCoords,
 
         Count
     };
 
     enum class Attributes : uint8_t
     {
-        Center = 0,
-        TexCoords,
-        Color,
+        StartCenter = 0,
+        EndCenter,
+        StartColor,
+        EndColor,
         Size,
+        Lifetime,
+        TexCoords,
 
         Count
     };
@@ -64,21 +70,30 @@ public:
     virtual void update(float delta) override;
 
     static void spawn(glm::vec3 position, glm::vec3 end_position, glm::vec3 color, glm::vec3 end_color, float size, float end_size, float life_time);
+    static size_t getLiveParticleCount();
 
 private:
     ParticleEngine();
     void doRender(const glm::mat4& projection, const glm::mat4& view);
     void doSpawn(glm::vec3 position, glm::vec3 end_position, glm::vec3 color, glm::vec3 end_color, float size, float end_size, float life_time);
     void initialize();
+    void uploadRange(size_t first, size_t count);
 
     std::array<uint32_t, static_cast<size_t>(Uniforms::Count)> uniforms;
     std::array<uint32_t, static_cast<size_t>(Attributes::Count)> attributes{};
     gl::Buffers<static_cast<size_t>(Buffers::Count)> buffers{ gl::Unitialized{} };
 
-    std::vector<Particle> particles;
-    std::vector<Particle>::iterator first_expired;
-    
-    std::vector<ParticleData> particles_renderdata;
+    float time = 0.f;
+
+    // Ring buffer state. The live particles are the live_count slots before head.
+    size_t head = 0;
+    size_t live_count = 0;
+    // Slots written since the last upload, starting at dirty_first (in ring order).
+    size_t dirty_first = 0;
+    size_t dirty_count = 0;
+
+    std::vector<ParticleVertex> vertices; // CPU copy of the GPU buffer, vertices_per_instance entries per slot.
+    std::vector<float> expire_times; // Per slot, used to retire particles from the tail of the ring.
     sp::Shader* shader = nullptr;
 };
 
@@ -111,6 +111,14 @@ static const uint16_t CMD_UPDATE_MAIN_SCREEN = 0x0103;
 static const uint16_t CMD_UPDATE_MAIN_SCREEN_CONTROL = 0x0104;
 static const uint16_t CMD_UPDATE_NAME = 0x0105;
 
+//Transport commands
+static const uint16_t CMD_BATCH = 0x0201;
+static const uint16_t CMD_BATCH_END = 0x0202;
+
+//Queued commands are sent at most this often, and a batch is sent early once it holds this many commands.
+static constexpr float command_flush_interval = 1.0f / 30.0f;
+static constexpr uint32_t max_commands_per_batch = 128;
+
 P<PlayerInfo> my_player_info;
 sp::ecs::Entity my_spaceship;
 PVector<PlayerInfo> player_info_list;
@@ -123,6 +131,7 @@ PlayerInfo::PlayerInfo()
     main_screen_control = 0;
     last_ship_password = "";
     registerMemberReplication(&client_id);
+    command_flush_timer.repeat(command_flush_interval);
 
     registerMemberReplication(&crew_positions);
     registerMemberReplication(&ship);
@@ -159,71 +168,137 @@ bool PlayerInfo::isOnlyMainScreen(int monitor_index)
     return crew_positions[monitor_index].mask == 0;
 }
 
+void PlayerInfo::update(float delta)
+{
+    if (!command_flush_timer.isExpired())
+        return;
+    if (command_batch_count == 0 && coalesced_commands.empty())
+        return;
+    flushCommands();
+}
+
+sp::io::DataBuffer& PlayerInfo::queueCommand()
+{
+    //Commands that were coalesced so far go first, so the server sees everything in the order it was issued.
+    writeCoalescedCommands();
+    if (command_batch_count >= max_commands_per_batch)
+        flushCommands();
+    if (command_batch_count == 0)
+        command_batch << CMD_BATCH;
+    command_batch_count++;
+    command_statistics.sent++;
+    return command_batch;
+}
+
+void PlayerInfo::queueCoalescedCommand(uint16_t command, int32_t key, float value, glm::vec2 position)
+{
+    //Setting a new rotation target or turn speed both override the other, so they share a slot.
+    uint16_t slot = command == CMD_TURN_SPEED ? CMD_TARGET_ROTATION : command;
+    for(auto& c : coalesced_commands)
+    {
+        if (c.slot == slot && c.key == key)
+        {
+            c.command = command;
+            c.value = value;
+            c.position = position;
+            command_statistics.coalesced++;
+            return;
+        }
+    }
+    coalesced_commands.push_back({slot, command, key, value, position});
+}
+
+void PlayerInfo::writeCoalescedCommands()
+{
+    if (coalesced_commands.empty())
+        return;
+    //Move the list out, as queueCommand writes pending coalesced commands itself.
+    auto commands = std::move(coalesced_commands);
+    coalesced_commands.clear();
+    for(auto& c : commands)
+    {
+        auto& packet = queueCommand();
+        switch(c.command)
+        {
+        case CMD_SET_SYSTEM_POWER_REQUEST:
+        case CMD_SET_SYSTEM_COOLANT_REQUEST:
+            packet << c.command << ShipSystem::Type(c.key) << c.value;
+            break;
+        case CMD_MOVE_WAYPOINT:
+            packet << c.command << c.key << c.position;
+            break;
+        default:
+            packet << c.command << c.value;
+            break;
+        }
+    }
+}
+
+void PlayerInfo::flushCommands()
+{
+    writeCoalescedCommands();
+    if (command_batch_count == 0)
+        return;
+    command_batch << CMD_BATCH_END;
+    sendClientCommand(command_batch);
+    command_statistics.packets++;
+    command_batch = sp::io::DataBuffer();
+    command_batch_count = 0;
+}
+
 // Client-side functions to send a command to the server.
 void PlayerInfo::commandTargetRotation(float target)
 {
-    sp::io::DataBuffer packet;
-    packet << CMD_TARGET_ROTATION << target;
-    sendClientCommand(packet);
+    queueCoalescedCommand(CMD_TARGET_ROTATION, -1, target);
 }
 
 void PlayerInfo::commandTurnSpeed(float turnSpeed)
 {
-    sp::io::DataBuffer packet;
-    packet << CMD_TURN_SPEED << turnSpeed;
-    sendClientCommand(packet);
+    queueCoalescedCommand(CMD_TURN_SPEED, -1, turnSpeed);
 }
 
 void PlayerInfo::commandImpulse(float target)
 {
-    sp::io::DataBuffer packet;
-    packet << CMD_IMPULSE << target;
-    sendClientCommand(packet);
+    queueCoalescedCommand(CMD_IMPULSE, -1, target);
 }
 
 void PlayerInfo::commandWarp(int target)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_WARP << target;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandJump(float distance)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_JUMP << distance;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandSetTarget(sp::ecs::Entity target)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     if (target)
         packet << CMD_SET_TARGET << target;
     else
         packet << CMD_SET_TARGET << sp::ecs::Entity();
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandLoadTube(uint32_t tubeNumber, EMissileWeapons missileType)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_LOAD_TUBE << tubeNumber << missileType;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandUnloadTube(uint32_t tubeNumber)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_UNLOAD_TUBE << tubeNumber;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandFireTube(uint32_t tubeNumber, float missile_target_angle)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_FIRE_TUBE << tubeNumber << missile_target_angle;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandFireTubeAtTarget(uint32_t tubeNumber, sp::ecs::Entity target)
@@ -245,176 +320,149 @@ void PlayerInfo::commandFireTubeAtTarget(uint32_t tubeNumber, sp::ecs::Entity ta
 
 void PlayerInfo::commandSetShields(bool enabled)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_SET_SHIELDS << enabled;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandMainScreenSetting(MainScreenSetting mainScreen)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_SET_MAIN_SCREEN_SETTING << mainScreen;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandMainScreenOverlay(MainScreenOverlay mainScreen)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_SET_MAIN_SCREEN_OVERLAY << mainScreen;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandScan(sp::ecs::Entity object)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_SCAN_OBJECT << object;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandSetSystemPowerRequest(ShipSystem::Type system, float power_request)
 {
-    sp::io::DataBuffer packet;
     auto sys = ShipSystem::get(ship, system);
     if (sys) sys->power_request = power_request;
-    packet << CMD_SET_SYSTEM_POWER_REQUEST << system << power_request;
-    sendClientCommand(packet);
+    queueCoalescedCommand(CMD_SET_SYSTEM_POWER_REQUEST, int32_t(system), power_request);
 }
 
 void PlayerInfo::commandSetSystemCoolantRequest(ShipSystem::Type system, float coolant_request)
 {
-    sp::io::DataBuffer packet;
     auto sys = ShipSystem::get(ship, system);
     if (sys) sys->coolant_request = coolant_request;
-    packet << CMD_SET_SYSTEM_COOLANT_REQUEST << system << coolant_request;
-    sendClientCommand(packet);
+    queueCoalescedCommand(CMD_SET_SYSTEM_COOLANT_REQUEST, int32_t(system), coolant_request);
 }
 
 void PlayerInfo::commandDock(sp::ecs::Entity object)
 {
     if (!object) return;
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_DOCK << object;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandUndock()
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_UNDOCK;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandAbortDock()
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_ABORT_DOCK;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandOpenTextComm(sp::ecs::Entity obj)
 {
     if (!obj) return;
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_OPEN_TEXT_COMM << obj;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandCloseTextComm()
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_CLOSE_TEXT_COMM;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandAnswerCommHail(bool awnser)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_ANSWER_COMM_HAIL << awnser;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandSendComm(uint8_t index)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_SEND_TEXT_COMM << index;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandSendCommPlayer(string message)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_SEND_TEXT_COMM_PLAYER << message;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandSetAutoRepair(bool enabled)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_SET_AUTO_REPAIR << enabled;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandSetBeamFrequency(int32_t frequency)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_SET_BEAM_FREQUENCY << frequency;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandSetBeamSystemTarget(ShipSystem::Type system)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_SET_BEAM_SYSTEM_TARGET << system;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandSetShieldFrequency(int32_t frequency)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_SET_SHIELD_FREQUENCY << frequency;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandAddWaypoint(glm::vec2 position)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_ADD_WAYPOINT << position;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandRemoveWaypoint(int32_t index)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_REMOVE_WAYPOINT << index;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandMoveWaypoint(int32_t index, glm::vec2 position)
 {
-    sp::io::DataBuffer packet;
-    packet << CMD_MOVE_WAYPOINT << index << position;
-    sendClientCommand(packet);
+    queueCoalescedCommand(CMD_MOVE_WAYPOINT, index, 0.0f, position);
 }
 
 void PlayerInfo::commandActivateSelfDestruct()
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_ACTIVATE_SELF_DESTRUCT;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandCancelSelfDestruct()
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_CANCEL_SELF_DESTRUCT;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandConfirmDestructCode(int8_t index, uint32_t code)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_CONFIRM_SELF_DESTRUCT << index << code;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandCombatManeuverBoost(float amount)
@@ -422,9 +470,7 @@ void PlayerInfo::commandCombatManeuverBoost(float amount)
     auto combat = ship.getComponent<CombatManeuveringThrusters>();
     if (!combat) return;
     combat->boost.request = amount;
-    sp::io::DataBuffer packet;
-    packet << CMD_COMBAT_MANEUVER_BOOST << amount;
-    sendClientCommand(packet);
+    queueCoalescedCommand(CMD_COMBAT_MANEUVER_BOOST, -1, amount);
 }
 
 void PlayerInfo::commandCombatManeuverStrafe(float amount)
@@ -432,67 +478,57 @@ void PlayerInfo::commandCombatManeuverStrafe(float amount)
     auto combat = ship.getComponent<CombatManeuveringThrusters>();
     if (!combat) return;
     combat->strafe.request = amount;
-    sp::io::DataBuffer packet;
-    packet << CMD_COMBAT_MANEUVER_STRAFE << amount;
-    sendClientCommand(packet);
+    queueCoalescedCommand(CMD_COMBAT_MANEUVER_STRAFE, -1, amount);
 }
 
 void PlayerInfo::commandLaunchProbe(glm::vec2 target_position)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_LAUNCH_PROBE << target_position;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandScanDone()
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_SCAN_DONE;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandScanCancel()
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_SCAN_CANCEL;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandSetAlertLevel(AlertLevel level)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_SET_ALERT_LEVEL;
     packet << level;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandHackingFinished(sp::ecs::Entity target, ShipSystem::Type target_system)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_HACKING_FINISHED;
     packet << target;
     packet << target_system;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandCustomFunction(string name)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_CUSTOM_FUNCTION;
     packet << name;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandSetScienceLink(sp::ecs::Entity probe)
 {
-    sp::io::DataBuffer packet;
-
     // Pass the probe's multiplayer ID if the probe isn't nullptr.
     if (probe)
     {
+        auto& packet = queueCommand();
         packet << CMD_SET_SCIENCE_LINK;
         packet << probe;
-        sendClientCommand(packet);
     }
     // Otherwise, it's invalid. Warn and do nothing.
     else
@@ -503,18 +539,17 @@ void PlayerInfo::commandSetScienceLink(sp::ecs::Entity probe)
 
 void PlayerInfo::commandClearScienceLink()
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
 
     packet << CMD_SET_SCIENCE_LINK;
     packet << sp::ecs::Entity{};
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::commandSetCrewPosition(int monitor_index, CrewPosition position, bool active)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_UPDATE_CREW_POSITION << uint32_t(monitor_index) << position << active;
-    sendClientCommand(packet);
+    flushCommands();
 
     if (crew_positions.size() <= size_t(monitor_index))
         crew_positions.resize(monitor_index + 1);
@@ -528,16 +563,16 @@ void PlayerInfo::commandSetCrewPosition(int monitor_index, CrewPosition position
 
 void PlayerInfo::commandSetShip(sp::ecs::Entity entity)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_UPDATE_SHIP_ID << entity;
-    sendClientCommand(packet);
+    flushCommands();
 }
 
 void PlayerInfo::commandSetMainScreen(int monitor_index, bool enabled)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_UPDATE_MAIN_SCREEN << uint32_t(monitor_index) << enabled;
-    sendClientCommand(packet);
+    flushCommands();
 
     if (enabled)
         main_screen |= (1 << monitor_index);
@@ -547,9 +582,9 @@ void PlayerInfo::commandSetMainScreen(int monitor_index, bool enabled)
 
 void PlayerInfo::commandSetMainScreenControl(int monitor_index, bool control)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_UPDATE_MAIN_SCREEN_CONTROL << uint32_t(monitor_index) << control;
-    sendClientCommand(packet);
+    flushCommands();
 
     if (control)
         main_screen_control |= (1 << monitor_index);
@@ -559,27 +594,46 @@ void PlayerInfo::commandSetMainScreenControl(int monitor_index, bool control)
 
 void PlayerInfo::commandSetName(const string& name)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_UPDATE_NAME << name;
-    sendClientCommand(packet);
+    flushCommands();
 
     this->name = name;
 }
 
 void PlayerInfo::commandCrewSetTargetPosition(sp::ecs::Entity crew, glm::ivec2 position)
 {
-    sp::io::DataBuffer packet;
+    auto& packet = queueCommand();
     packet << CMD_CREW_SET_TARGET << crew << position;
-    sendClientCommand(packet);
 }
 
 void PlayerInfo::onReceiveClientCommand(int32_t client_id, sp::io::DataBuffer& packet)
 {
     if (client_id != this->client_id) return;
-    uint16_t command;
+    uint16_t command = CMD_BATCH_END;
+    packet >> command;
+    if (command != CMD_BATCH)
+    {
+        handleClientCommand(command, packet);
+        return;
+    }
+    //Each command reads exactly its own arguments, so the next command follows directly.
+    //  The end marker is also what we are left with when a packet is cut short.
+    for(uint32_t n=0; n<max_commands_per_batch; n++)
+    {
+        command = CMD_BATCH_END;
+        packet >> command;
+        if (command == CMD_BATCH_END)
+            break;
+        if (!handleClientCommand(command, packet))
+            break;
+    }
+}
+
+bool PlayerInfo::handleClientCommand(uint16_t command, sp::io::DataBuffer& packet)
+{
     uint32_t monitor_index;
     bool active;
-    packet >> command;
     switch(command)
     {
     case CMD_TARGET_ROTATION:{
@@ -900,14 +954,14 @@ void PlayerInfo::onReceiveClientCommand(int32_t client_id, sp::io::DataBuffer& p
                 combat->strafe.request = request_amount;
         }
         break;
-    case CMD_LAUNCH_PROBE:
+    case CMD_LAUNCH_PROBE:{
+        //Always read the target, so the next command in a batch starts at the right place.
+        glm::vec2 target{};
+        packet >> target;
         if (auto spl = ship.getComponent<ScanProbeLauncher>())
         {
             auto t = ship.getComponent<sp::Transform>();
             if (t && spl->stock > 0) {
-                glm::vec2 target{};
-                packet >> target;
-
                 auto p = sp::ecs::Entity::create();
                 p.addComponent<sp::Transform>(*t);
                 p.addComponent<LifeTime>().lifetime = 60*10;
@@ -943,7 +997,7 @@ void PlayerInfo::onReceiveClientCommand(int32_t client_id, sp::io::DataBuffer& p
                 spl->stock--;
             }
         }
-        break;
+        }break;
     case CMD_SET_ALERT_LEVEL:{
         AlertLevel al;
         packet >> al;
@@ -1049,7 +1103,12 @@ void PlayerInfo::onReceiveClientCommand(int32_t client_id, sp::io::DataBuffer& p
             if (auto ic = crew.getComponent<InternalCrew>())
                 ic->target_position = position;
         }break;
+    default:
+        //We do not know how much to read, so nothing after this in a batch can be trusted.
+        LOG(WARNING) << "Unknown client command: " << command;
+        return false;
     }
+    return true;
 }
 
 void PlayerInfo::spawnUI(int monitor_index, RenderLayer* render_layer)
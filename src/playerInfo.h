@@ -2,6 +2,8 @@
 #define PLAYER_INFO_H
 
 #include "multiplayer.h"
+#include "Updatable.h"
+#include "timer.h"
 #include "components/player.h"
 #include "systems/shipsystemssystem.h"
 #include "missileWeaponData.h"
@@ -14,9 +16,16 @@ extern P<PlayerInfo> my_player_info;
 extern sp::ecs::Entity my_spaceship;
 extern PVector<PlayerInfo> player_info_list;
 
-class PlayerInfo : public MultiplayerObject
+class PlayerInfo : public MultiplayerObject, public Updatable
 {
 public:
+    struct CommandStatistics
+    {
+        uint32_t sent = 0;      //Commands written into packets.
+        uint32_t coalesced = 0; //Commands dropped because a newer value replaced them before sending.
+        uint32_t packets = 0;
+    };
+
     int32_t client_id;
 
     std::vector<CrewPositions> crew_positions;
@@ -87,10 +96,37 @@ public:
     void commandCrewSetTargetPosition(sp::ecs::Entity crew, glm::ivec2 target);
 
     virtual void onReceiveClientCommand(int32_t client_id, sp::io::DataBuffer& packet) override;
+    virtual void update(float delta) override;
+
+    //Send all queued commands right away, instead of at the next network tick.
+    void flushCommands();
+    const CommandStatistics& getCommandStatistics() const { return command_statistics; }
 
     void spawnUI(int monitor_index, RenderLayer* render_layer);
 
     static bool hasPlayerAtPosition(sp::ecs::Entity entity, CrewPosition position);
+private:
+    //Commands where only the last value matters (sliders, steering, waypoint drags) are kept here until the batch is sent,
+    //  and replaced in place when the same command is given again.
+    struct CoalescedCommand
+    {
+        uint16_t slot;
+        uint16_t command;
+        int32_t key;
+        float value;
+        glm::vec2 position;
+    };
+
+    sp::io::DataBuffer& queueCommand();
+    void queueCoalescedCommand(uint16_t command, int32_t key, float value, glm::vec2 position = {});
+    void writeCoalescedCommands();
+    bool handleClientCommand(uint16_t command, sp::io::DataBuffer& packet);
+
+    sp::io::DataBuffer command_batch;
+    uint32_t command_batch_count = 0;
+    std::vector<CoalescedCommand> coalesced_commands;
+    sp::SystemTimer command_flush_timer; //Real time, so commands are still sent while the game is paused.
+    CommandStatistics command_statistics;
 };
 
 string getCrewPositionName(CrewPosition position);
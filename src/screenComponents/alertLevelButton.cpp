@@ -6,7 +6,7 @@
 
 
 GuiAlertLevelSelect::GuiAlertLevelSelect(GuiContainer* owner, string id)
-: GuiElement(owner, id)
+: GuiCachedContainer(owner, id)
 {
     // Alert level buttons.
     auto alert_level_button = new GuiToggleButton(this, "", tr("Alert level"), [this](bool value)
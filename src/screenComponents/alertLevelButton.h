@@ -2,8 +2,10 @@
 #define ALERT_LEVEL_BUTTON_H
 
 #include "gui/gui2_button.h"
+#include "gui/gui2_cachedcontainer.h"
 
-class GuiAlertLevelSelect : public GuiElement
+//The alert level buttons only change when they are clicked or hovered, so they are drawn from a cached texture.
+class GuiAlertLevelSelect : public GuiCachedContainer
 {
 public:
     GuiAlertLevelSelect(GuiContainer* owner, string id);
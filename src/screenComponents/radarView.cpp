@@ -16,6 +16,7 @@
 #include "components/scanning.h"
 #include "systems/missilesystem.h"
 #include "systems/radarblock.h"
+#include "systems/radarvisibility.h"
 #include "systems/radar.h"
 #include "main.h"
 #include "gameGlobalInfo.h"
@@ -251,26 +252,47 @@ void GuiRadarView::onDraw(sp::RenderTarget& renderer)
     glDisable(GL_SCISSOR_TEST);
 }
 
+void GuiRadarView::GhostTrail::push(const GhostDot& dot)
+{
+    if (count == capacity)
+    {
+        first = (first + 1) % capacity;
+        count--;
+    }
+    dots[(first + count) % capacity] = dot;
+    count++;
+}
+
+void GuiRadarView::GhostTrail::trim(float now)
+{
+    while(count > 0 && dots[first].end_of_life <= now)
+    {
+        first = (first + 1) % capacity;
+        count--;
+    }
+}
+
 void GuiRadarView::updateGhostDots()
 {
-    if (next_ghost_dot_update < engine->getElapsedTime())
+    float now = engine->getElapsedTime();
+    if (next_ghost_dot_update < now)
     {
-        next_ghost_dot_update = engine->getElapsedTime() + 5.0f;
+        next_ghost_dot_update = now + GhostDot::interval;
         for(auto [entity, impulse, transform] : sp::ecs::Query<ImpulseEngine, sp::Transform>())
         {
-            if (glm::length(transform.getPosition() - view_position) < distance)
+            if (glm::length2(transform.getPosition() - view_position) < distance * distance)
             {
-                ghost_dots.push_back(GhostDot(transform.getPosition()));
+                ghost_trails[entity.getIndex()].push(GhostDot(transform.getPosition()));
             }
         }
 
-        for(unsigned int n=0; n < ghost_dots.size(); n++)
+        for(auto it = ghost_trails.begin(); it != ghost_trails.end(); )
         {
-            if (ghost_dots[n].end_of_life <= engine->getElapsedTime())
-            {
-                ghost_dots.erase(ghost_dots.begin() + n);
-                n--;
-            }
+            it->second.trim(now);
+            if (it->second.count == 0)
+                it = ghost_trails.erase(it);
+            else
+                ++it;
         }
     }
 }
@@ -417,9 +439,18 @@ void GuiRadarView::drawNebulaBlockedAreas(sp::RenderTarget& renderer)
 
 void GuiRadarView::drawGhostDots(sp::RenderTarget& renderer)
 {
-    for(unsigned int n=0; n<ghost_dots.size(); n++)
+    //Only draw dots that can be inside the radar rect, which is within half its diagonal from the view center.
+    float now = engine->getElapsedTime();
+    float view_radius = distance * glm::length(rect.size) / std::min(rect.size.x, rect.size.y);
+    for(auto& [index, trail] : ghost_trails)
     {
-        renderer.drawPoint(worldToScreen(ghost_dots[n].position), glm::u8vec4(255, 255, 255, 255 * std::max(((ghost_dots[n].end_of_life - engine->getElapsedTime()) / GhostDot::total_lifetime), 0.f)));
+        for(int n=0; n<trail.count; n++)
+        {
+            auto& dot = trail.get(n);
+            if (glm::length2(dot.position - view_position) > view_radius * view_radius)
+                continue;
+            renderer.drawPoint(worldToScreen(dot.position), glm::u8vec4(255, 255, 255, 255 * std::max(((dot.end_of_life - now) / GhostDot::total_lifetime), 0.f)));
+        }
     }
 }
 
@@ -596,69 +627,15 @@ void GuiRadarView::drawObjects(sp::RenderTarget& renderer)
             visible_objects.set(entity.getIndex());
         break;
     case FriendlysShortRangeFogOfWar:
-        // Reveal objects if they are within short-range radar range (or 5U) of
-        // a friendly ship, station, or scan probe.
-
         // Continue only if the player's ship exists.
         if (!my_spaceship)
         {
             return;
         }
-
-        // For each SpaceObject on the map...
-        for(auto [entity, transform] : sp::ecs::Query<sp::Transform>())
-        {
-            // If the object can't hide in a nebula, it's considered visible.
-            if (entity.hasComponent<NeverRadarBlocked>()) {
-                visible_objects.set(entity.getIndex());
-                continue;
-            }
-
-            // Consider the object only if it is:
-            // - Any ShipTemplateBasedObject (ship or station)
-            // - A SpaceObject belonging to a friendly faction
-            // - The player's ship
-            // - A scan probe owned by the player's ship
-            // This check is duplicated in RelayScreen::onDraw.
-            if (!entity.hasComponent<ShareShortRangeRadar>())
-                continue;
-            if (Faction::getRelation(my_spaceship, entity) != FactionRelation::Friendly)
-                continue;
-
-            // Set the radius to reveal as getShortRangeRadarRange() if the
-            // object's a ShipTemplateBasedObject. Otherwise, default to 5U.
-            float r = entity.getComponent<LongRangeRadar>() ? entity.getComponent<LongRangeRadar>()->short_range : 5000.0f;
-
-            // Query for objects within short-range radar/5U of this object.
-            auto position = transform.getPosition();
-
-            // For each of those objects, check if it is at least partially
-            // inside the revealed radius. If so, reveal the object on the map.
-            for(auto entity2 : sp::CollisionSystem::queryArea(position - glm::vec2(r, r), position + glm::vec2(r, r)))
-            {
-                //TODO: This isn't great, as not everything will collision attached...
-                auto trace = entity2.getComponent<RadarTrace>();
-                float r2 = r + (trace ? trace->radius : 300.0f);
-                if (auto t2 = entity2.getComponent<sp::Transform>()) {
-                    if (glm::length2(transform.getPosition() - t2->getPosition()) < r2*r2)
-                        visible_objects.set(entity2.getIndex());
-                }
-            }
-        }
-
+        visible_objects = RadarVisibilitySystem::getVisibleObjects(RadarVisibilitySystem::Mode::FriendlyShortRange, my_spaceship);
         break;
     case NebulaFogOfWar:
-        if (auto transform = my_spaceship.getComponent<sp::Transform>())
-        {
-            auto lrr = my_spaceship.getComponent<LongRangeRadar>();
-            auto short_range = lrr ? lrr->short_range : 5000.0f;
-            for(auto [entity, t] : sp::ecs::Query<sp::Transform>())
-            {
-                if (RadarBlockSystem::isRadarBlockedFrom(transform->getPosition(), entity, short_range))
-                    continue;
-                visible_objects.set(entity.getIndex());
-            }
-        }
+        visible_objects = RadarVisibilitySystem::getVisibleObjects(RadarVisibilitySystem::Mode::Nebula, my_spaceship);
         break;
     }
 
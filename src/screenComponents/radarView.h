@@ -4,6 +4,9 @@
 #include "gui/gui2_element.h"
 #include "engine.h"
 
+#include <array>
+#include <unordered_map>
+
 
 class GuiMissileTubeControls;
 class TargetsContainer;
@@ -32,13 +35,30 @@ private:
     {
     public:
         constexpr static float total_lifetime = 60.0f;
+        constexpr static float interval = 5.0f;
 
         glm::vec2 position{};
         float end_of_life;
 
+        GhostDot() : end_of_life(0.0f) {}
         GhostDot(glm::vec2 pos) : position(pos), end_of_life(engine->getElapsedTime() + total_lifetime) {}
     };
-    std::vector<GhostDot> ghost_dots;
+    //History of a single entity. Dots expire in the order they were added,
+    //  so a fixed size ring buffer holds all that are still alive.
+    class GhostTrail
+    {
+    public:
+        constexpr static int capacity = int(GhostDot::total_lifetime / GhostDot::interval) + 1;
+
+        std::array<GhostDot, capacity> dots;
+        int first = 0;
+        int count = 0;
+
+        const GhostDot& get(int n) const { return dots[(first + n) % capacity]; }
+        void push(const GhostDot& dot);
+        void trim(float now);
+    };
+    std::unordered_map<uint32_t, GhostTrail> ghost_trails; //Keyed on entity index.
     float next_ghost_dot_update;
 
     TargetsContainer* targets;
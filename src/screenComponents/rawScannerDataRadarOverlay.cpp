@@ -5,6 +5,9 @@
 #include "components/collision.h"
 #include "components/radar.h"
 #include "ecs/query.h"
+#include "main.h"
+#include <glm/gtx/norm.hpp>
+#include <cmath>
 
 
 RawScannerDataRadarOverlay::RawScannerDataRadarOverlay(GuiRadarView* owner, string id)
@@ -13,44 +16,34 @@ RawScannerDataRadarOverlay::RawScannerDataRadarOverlay(GuiRadarView* owner, stri
     setSize(GuiElement::GuiSizeMax, GuiElement::GuiSizeMax);
 }
 
-void RawScannerDataRadarOverlay::onDraw(sp::RenderTarget& renderer)
+void RawScannerDataRadarOverlay::updateSignatures(glm::vec2 view_position, float distance)
 {
-    if (!my_spaceship)
-        return;
-    auto distance = radar->getDistance();
-
-    auto view_position = radar->getViewPosition();
-    float view_rotation = radar->getViewRotation();
-
-    // Cap the number of signature points, which determines the raw data's
-    // resolution.
-    const int point_count = 512;
-    float radius = std::min(rect.size.x, rect.size.y) / 2.0f;
-
-    RawRadarSignatureInfo signatures[point_count];
+    gravity.fill(0.0f);
+    electrical.fill(0.0f);
+    biological.fill(0.0f);
 
     // For each SpaceObject ...
-    for(auto [entity, signature, dynamic_signature, transform] : sp::ecs::Query<RawRadarSignatureInfo, sp::ecs::optional<DynamicRadarSignatureInfo>, sp::Transform>())
+    for(auto [entity, signature, dynamic_signature, transform, physics] : sp::ecs::Query<RawRadarSignatureInfo, sp::ecs::optional<DynamicRadarSignatureInfo>, sp::Transform, sp::ecs::optional<sp::Physics>>())
     {
         // Don't measure our own ship.
         if (entity == my_spaceship)
             continue;
 
+        // If the object is more than twice as far away as the maximum radar
+        // range, disregard it. Checked on the squared distance first, as most objects fail this.
+        auto diff = transform.getPosition() - view_position;
+        if (glm::length2(diff) > distance * distance * 4.0f)
+            continue;
+
         // Initialize angle, distance, and scale variables.
         float a_0, a_1;
-        float dist = glm::length(transform.getPosition() - view_position);
+        float dist = glm::length(diff);
         float scale = 1.0;
 
-        // If the object is more than twice as far away as the maximum radar
-        // range, disregard it.
-        if (dist > distance * 2.0f)
-            continue;
-
         // The further away the object is, the less its effect on radar data.
         if (dist > distance)
             scale = 1.0f - ((dist - distance) / distance);
 
-        auto physics = entity.getComponent<sp::Physics>();
         // If we're adjacent to the object ...
         if (physics && dist <= physics->getSize().x)
         {
@@ -61,7 +54,10 @@ void RawScannerDataRadarOverlay::onDraw(sp::RenderTarget& renderer)
             // Otherwise, measure the affected range of angles by the object's
             // distance and radius.
             float a_diff = glm::degrees(asinf((physics ? physics->getSize().x : 300.0f) / dist));
-            float a_center = vec2ToAngle(transform.getPosition() - view_position);
+            // Objects without physics closer than the default radius have no valid angle, they do not affect any data point.
+            if (!std::isfinite(a_diff))
+                continue;
+            float a_center = vec2ToAngle(diff);
             a_0 = a_center - a_diff;
             a_1 = a_center + a_diff;
         }
@@ -76,16 +72,57 @@ void RawScannerDataRadarOverlay::onDraw(sp::RenderTarget& renderer)
             info.electrical += dynamic_signature->electrical;
             info.biological += dynamic_signature->biological;
         }
-
-        // For each interval determined by the level of raw data resolution,
-        // initialize the signatures array.
-        for(float a = a_0; a <= a_1; a += 360.f / float(point_count))
+        info = info * scale;
+
+        // Add the signature to every data point covered by the range of angles,
+        // as at most two contiguous runs of points, so the inner loops vectorize.
+        int first = int(std::floor(a_0 / 360.0f * point_count));
+        int count = std::min(int((a_1 - a_0) / 360.0f * point_count) + 1, point_count);
+        first = ((first % point_count) + point_count) % point_count;
+        int run_end = std::min(first + count, point_count);
+        for(int n=first; n<run_end; n++)
+        {
+            gravity[n] += info.gravity;
+            electrical[n] += info.electrical;
+            biological[n] += info.biological;
+        }
+        run_end = first + count - point_count;
+        for(int n=0; n<run_end; n++)
         {
-            int idx = (int(a / 360.0f * point_count) + point_count * 2) % point_count;
-            signatures[idx] += info * scale;
+            gravity[n] += info.gravity;
+            electrical[n] += info.electrical;
+            biological[n] += info.biological;
         }
     }
 
+    for(int n=0; n<point_count; n++)
+    {
+        gravity[n] = std::clamp(gravity[n], 0.0f, 1.0f);
+        electrical[n] = std::clamp(electrical[n], 0.0f, 1.0f);
+        biological[n] = std::clamp(biological[n], 0.0f, 1.0f);
+    }
+}
+
+void RawScannerDataRadarOverlay::onDraw(sp::RenderTarget& renderer)
+{
+    if (!my_spaceship)
+        return;
+    auto distance = radar->getDistance();
+
+    auto view_position = radar->getViewPosition();
+    float view_rotation = radar->getViewRotation();
+
+    float radius = std::min(rect.size.x, rect.size.y) / 2.0f;
+
+    // Zooming changes the signatures at once, so don't wait for the next update.
+    float now = engine->getElapsedTime();
+    if (now >= next_update_time || distance != signature_distance)
+    {
+        updateSignatures(view_position, distance);
+        next_update_time = now + update_interval;
+        signature_distance = distance;
+    }
+
     // Initialize the data's amplitude along each of the three color bands.
     float amp_r[point_count];
     float amp_g[point_count];
@@ -94,11 +131,6 @@ void RawScannerDataRadarOverlay::onDraw(sp::RenderTarget& renderer)
     // For each data point ...
     for(int n = 0; n < point_count; n++)
     {
-        // ... initialize its values in the array ...
-        signatures[n].gravity = std::max(0.0f, std::min(1.0f, signatures[n].gravity));
-        signatures[n].electrical = std::max(0.0f, std::min(1.0f, signatures[n].electrical));
-        signatures[n].biological = std::max(0.0f, std::min(1.0f, signatures[n].biological));
-
         // ... make some noise ...
         float r = random(-1, 1);
         float g = random(-1, 1);
@@ -106,13 +138,13 @@ void RawScannerDataRadarOverlay::onDraw(sp::RenderTarget& renderer)
 
         // ... and then modify the bands' values based on the object's signature.
         // Biological signatures amplify the green band.
-        g += signatures[n].biological * 30;
+        g += biological[n] * 30;
 
         // Electrical signatures amplify the red band.
-        r += random(-20, 20) * signatures[n].electrical;
+        r += random(-20, 20) * electrical[n];
 
         // Gravitational signatures amplify the blue band.
-        b = b * (1.0f - signatures[n].gravity) + 40 * signatures[n].gravity;
+        b = b * (1.0f - gravity[n]) + 40 * gravity[n];
 
         // Apply the values to the radar bands.
         amp_r[n] = r;
@@ -124,6 +156,9 @@ void RawScannerDataRadarOverlay::onDraw(sp::RenderTarget& renderer)
     std::vector<glm::vec2> a_r;
     std::vector<glm::vec2> a_g;
     std::vector<glm::vec2> a_b;
+    a_r.reserve(point_count + 1);
+    a_g.reserve(point_count + 1);
+    a_b.reserve(point_count + 1);
 
     // For each data point ...
     for(int n = 0; n < point_count; n++)
@@ -3,6 +3,8 @@
 
 #include "gui/gui2_element.h"
 
+#include <array>
+
 class GuiRadarView;
 
 // Class for drawing the Science Bands (red, green, blue) around the Radar for the Science Station
@@ -13,7 +15,20 @@ public:
 
     virtual void onDraw(sp::RenderTarget& target) override;
 private:
+    // Cap the number of signature points, which determines the raw data's
+    // resolution.
+    static constexpr int point_count = 512;
+    // The signatures only change slowly, so they are accumulated at a lower rate than the frame rate.
+    static constexpr float update_interval = 1.0f / 15.0f;
+
+    void updateSignatures(glm::vec2 view_position, float distance);
+
     GuiRadarView* radar;
+    std::array<float, point_count> gravity;
+    std::array<float, point_count> electrical;
+    std::array<float, point_count> biological;
+    float next_update_time = 0.0f;
+    float signature_distance = -1.0f;
 };
 
 #endif//RAW_SCANNER_DATA_RADAR_OVERLAY_H
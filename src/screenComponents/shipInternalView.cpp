@@ -1,7 +1,7 @@
 #include "playerInfo.h"
 #include "shipInternalView.h"
 #include "components/internalrooms.h"
-#include "ecs/query.h"
+#include "systems/internalcrew.h"
 
 
 GuiShipInternalView::GuiShipInternalView(GuiContainer* owner, string id, float room_size)
@@ -70,8 +70,7 @@ void GuiShipInternalView::onDraw(sp::RenderTarget& target)
         room_container = nullptr;
         crew_list.clear();
     }else{
-        for(auto [entity, ic] : sp::ecs::Query<InternalCrew>()) {
-            if (ic.ship != viewing_ship) continue;
+        for(auto entity : InternalCrewSystem::getCrew(viewing_ship)) {
             bool found = false;
             for(auto gsc : crew_list) {
                 if (gsc->crew == entity) {
@@ -104,8 +103,7 @@ void GuiShipInternalView::onUpdate()
         {
             bool found = false;
             sp::ecs::Entity first;
-            for(auto [entity, ic] : sp::ecs::Query<InternalCrew>()) {
-                if (ic.ship != viewing_ship) continue;
+            for(auto entity : InternalCrewSystem::getCrew(viewing_ship)) {
                 if (!first) first = entity;
                 if (entity == selected_crew_member) {
                     found = true;
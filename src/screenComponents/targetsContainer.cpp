@@ -6,6 +6,7 @@
 #include "components/scanning.h"
 #include "components/radar.h"
 #include "ecs/query.h"
+#include <algorithm>
 
 
 TargetsContainer::TargetsContainer()
@@ -120,85 +121,77 @@ void TargetsContainer::setWaypointIndex(int index)
 void TargetsContainer::setNext(glm::vec2 position, float max_range, ESelectionType selection_type)
 {
     std::vector<sp::ecs::Entity> entities;
-
-    for(auto [entity, transform] : sp::ecs::Query<sp::Transform>()) {
-        if(isValidTarget(entity, selection_type) && glm::distance(position, transform.getPosition()) <= max_range) {
+    for(auto entity : sp::CollisionSystem::queryArea(position - glm::vec2(max_range, max_range), position + glm::vec2(max_range, max_range))) {
+        auto transform = entity.getComponent<sp::Transform>();
+        if(transform && isValidTarget(entity, selection_type) && glm::length2(position - transform->getPosition()) <= max_range * max_range) {
             entities.push_back(entity);
         }
     }
 
-    sortByDistance(position, entities);
     setNext(position, max_range, entities);
 }
 
 void TargetsContainer::setNext(glm::vec2 position, float max_range, ESelectionType selection_type, FactionRelation relation)
 {
+    // Relations are looked up in our own faction info, which is the same for every candidate.
+    auto& faction_info = Faction::getInfo(my_spaceship);
     std::vector<sp::ecs::Entity> entities;
-    for(auto [entity, transform] : sp::ecs::Query<sp::Transform>()) {
-        if(isValidTarget(entity, selection_type) && glm::distance(position, transform.getPosition()) <= max_range && Faction::getRelation(my_spaceship, entity) == relation) {
+    for(auto entity : sp::CollisionSystem::queryArea(position - glm::vec2(max_range, max_range), position + glm::vec2(max_range, max_range))) {
+        auto transform = entity.getComponent<sp::Transform>();
+        if(!transform || !isValidTarget(entity, selection_type) || glm::length2(position - transform->getPosition()) > max_range * max_range)
+            continue;
+        auto faction = entity.getComponent<Faction>();
+        if(faction_info.getRelation(faction ? faction->entity : sp::ecs::Entity{}) == relation) {
             entities.push_back(entity);
         }
     }
 
-    sortByDistance(position, entities);
     setNext(position, max_range, entities);
 }
 
 void TargetsContainer::setNext(glm::vec2 position, float max_range, std::vector<sp::ecs::Entity> &entities)
 {
-    sp::ecs::Entity default_target;
-    sp::ecs::Entity current_target;
-    glm::vec2 default_target_position;
+    // Select the entity that comes after the current target when ordered by distance,
+    // or the closest entity if the current target is not a candidate or is the furthest.
+    // Both are found in a single pass, instead of sorting all candidates.
+    auto before = [](float distance_a, sp::ecs::Entity a, float distance_b, sp::ecs::Entity b) {
+        if (distance_a != distance_b)
+            return distance_a < distance_b;
+        return a.getIndex() < b.getIndex();
+    };
+
+    auto current_target = get();
+    float current_distance = 0.0f;
+    bool current_is_candidate = false;
+    if (auto transform = current_target.getComponent<sp::Transform>()) {
+        current_distance = glm::length2(position - transform->getPosition());
+        current_is_candidate = std::find(entities.begin(), entities.end(), current_target) != entities.end();
+    }
 
+    sp::ecs::Entity default_target;
+    float default_distance = 0.0f;
+    sp::ecs::Entity next_target;
+    float next_distance = 0.0f;
     for (auto entity : entities) {
         auto transform = entity.getComponent<sp::Transform>();
-
         if (!transform)
             continue;
+        float distance = glm::length2(position - transform->getPosition());
 
-        // Start collecting nearest relevant entities in case we never run into a previous target
-        if (!default_target ||
-                glm::length2(position - transform->getPosition()) <
-                glm::length2(position - default_target_position)) {
+        if (!default_target || before(distance, entity, default_distance, default_target)) {
             default_target = entity;
-            default_target_position = transform->getPosition();
-        }
-
-        // if we set a current target in the last iteration (condition below)
-        // the set the entity to be this next entity in the list.
-        if (current_target) {
-            set(entity);
-            my_player_info->commandSetTarget(get());
-            return;
+            default_distance = distance;
         }
-
-        if (get() == entity) {
-            current_target = entity;
+        if (current_is_candidate && before(current_distance, current_target, distance, entity) && (!next_target || before(distance, entity, next_distance, next_target))) {
+            next_target = entity;
+            next_distance = distance;
         }
     }
 
-    // If we didn't short-circuit because of an existing target above, set the
-    // target to be the default_target (closest to `position`)
-    set(default_target);
+    set(next_target ? next_target : default_target);
     my_player_info->commandSetTarget(get());
 }
 
-void TargetsContainer::sortByDistance(glm::vec2 position, std::vector<sp::ecs::Entity>& entities)
-{
-    sort(entities.begin(), entities.end(), [position](sp::ecs::Entity a, sp::ecs::Entity b) {
-        auto transform_a = a.getComponent<sp::Transform>();
-        auto transform_b = b.getComponent<sp::Transform>();
-        if (!transform_a)
-            return bool(transform_b);
-
-        if (!transform_b)
-            return bool(transform_a);
-
-        return glm::distance(position, transform_a->getPosition()) < glm::distance(position, transform_b->getPosition());
-    });
-
-}
-
 bool TargetsContainer::isValidTarget(sp::ecs::Entity entity, ESelectionType selection_type)
 {
     if (entity == my_spaceship) return false;
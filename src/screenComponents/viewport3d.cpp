@@ -33,6 +33,7 @@ GuiViewport3D::GuiViewport3D(GuiContainer* owner, string id)
     show_callsigns = false;
     show_headings = false;
     show_spacedust = false;
+    particle_budget = PreferencesManager::get("particle_budget", "16384").toInt();
 
     // Load up our starbox into a cubemap.
     // Setup shader.
@@ -245,7 +246,12 @@ void GuiViewport3D::onDraw(sp::RenderTarget& renderer)
     }
     glDepthMask(GL_TRUE);
 
-    // Emit engine particles.
+    // Emit engine particles. Once the live particle count exceeds our budget, thin out the engine trails
+    // proportionally instead of letting the particle ring overwrite (and pop) older particles.
+    float emit_chance = 1.0f;
+    auto live_particles = ParticleEngine::getLiveParticleCount();
+    if (live_particles > particle_budget)
+        emit_chance = float(particle_budget) / float(live_particles);
     for(auto [entity, ee, transform, impulse] : sp::ecs::Query<EngineEmitter, sp::Transform, ImpulseEngine>()) {
         if (impulse.actual != 0.0f) {
             float engine_scale = std::abs(impulse.actual);
@@ -253,6 +259,8 @@ void GuiViewport3D::onDraw(sp::RenderTarget& renderer)
             {
                 for(auto ed : ee.emitters)
                 {
+                    if (emit_chance < 1.0f && random(0.0f, 1.0f) > emit_chance)
+                        continue;
                     glm::vec3 offset = ed.position;
                     glm::vec2 pos2d = transform.getPosition() + rotateVec2(glm::vec2(offset.x, offset.y), transform.getRotation());
                     glm::vec3 color = ed.color;
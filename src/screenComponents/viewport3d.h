@@ -13,6 +13,7 @@ class GuiViewport3D : public GuiElement
     bool show_callsigns;
     bool show_headings;
     bool show_spacedust;
+    size_t particle_budget;
 
     glm::mat4 projection_matrix;
     glm::mat4 view_matrix;
@@ -70,6 +71,7 @@ public:
     GuiViewport3D* showCallsigns() { show_callsigns = true; return this; }
     GuiViewport3D* showHeadings() { show_headings = true; return this; }
     GuiViewport3D* showSpacedust() { show_spacedust = true; return this; }
+    GuiViewport3D* setParticleBudget(size_t budget) { particle_budget = budget; return this; }
 private:
     glm::vec3 worldToScreen(sp::RenderTarget& window, glm::vec3 world);
 };
@@ -372,10 +372,12 @@ void CrewStationScreen::tileViewport()
     {
         main_panel->setSize(1000, GuiElement::GuiSizeMax);
         main_panel->layout.fill_width = false;
+        main_panel->markLayoutDirty();
         viewport->setPosition(1000, 0, sp::Alignment::TopLeft);
     } else {
         main_panel->setSize(1200, GuiElement::GuiSizeMax);
         main_panel->layout.fill_width = false;
+        main_panel->markLayoutDirty();
         viewport->setPosition(1200, 0, sp::Alignment::TopLeft);
     }
 }
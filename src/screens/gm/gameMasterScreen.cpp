@@ -14,9 +14,13 @@
 #include "components/comms.h"
 #include "components/player.h"
 #include "components/name.h"
+#include "components/rendering.h"
+#include "components/zone.h"
+#include "components/radar.h"
 #include "components/docking.h"
 #include "systems/collision.h"
 #include "ecs/query.h"
+#include <container/bitset.h>
 #include "multiplayer_server.h"
 
 #include "screenComponents/radarView.h"
@@ -570,23 +574,48 @@ void GameMasterScreen::onMouseUp(glm::vec2 position)
             bool ctrl_down = SDL_GetModState() & KMOD_CTRL;
             bool alt_down = SDL_GetModState() & KMOD_ALT;
             std::vector<sp::ecs::Entity> entities;
-            for(auto [entity, transform, physics] : sp::ecs::Query<sp::Transform, sp::ecs::optional<sp::Physics>>())
-            {
-                auto size = physics ? std::max(physics->getSize().x, physics->getSize().y) : 0.0f;
-                if (transform.getPosition().x + size < std::min(drag_start_position.x, position.x))
-                    continue;
-                if (transform.getPosition().x - size > std::max(drag_start_position.x, position.x))
-                    continue;
-                if (transform.getPosition().y + size < std::min(drag_start_position.y, position.y))
-                    continue;
-                if (transform.getPosition().y - size > std::max(drag_start_position.y, position.y))
-                    continue;
+            glm::vec2 box_min(std::min(drag_start_position.x, position.x), std::min(drag_start_position.y, position.y));
+            glm::vec2 box_max(std::max(drag_start_position.x, position.x), std::max(drag_start_position.y, position.y));
+            auto is_selectable = [&](sp::ecs::Entity entity) {
                 if (ctrl_down && !entity.hasComponent<PlayerControl>() && !entity.hasComponent<AIController>() && !entity.hasComponent<DockingBay>())
-                    continue;
+                    return false;
                 if (alt_down && (!entity.hasComponent<Faction>() || (Faction::getInfo(entity).name != faction_selector->getSelectionValue())))
-                    continue;
-                entities.push_back(entity);
+                    return false;
+                return true;
+            };
+            //Same test as before the broad-phase was used: the object's position, grown by its size, has to overlap the box.
+            auto overlaps_box = [&](sp::Transform& transform, sp::Physics* physics) {
+                auto p = transform.getPosition();
+                auto size = physics ? std::max(physics->getSize().x, physics->getSize().y) : 0.0f;
+                return p.x + size >= box_min.x && p.x - size <= box_max.x && p.y + size >= box_min.y && p.y - size <= box_max.y;
+            };
+            //Objects with a collision body are found through the collision broad-phase.
+            for(auto entity : sp::CollisionSystem::queryArea(box_min, box_max))
+            {
+                auto transform = entity.getComponent<sp::Transform>();
+                if (transform && overlaps_box(*transform, entity.getComponent<sp::Physics>()) && is_selectable(entity))
+                    entities.push_back(entity);
             }
+            //Objects without a body (visual asteroids, nebulae, zones, planets without collision) are invisible to the broad-phase.
+            //  Gather them through the components that make an object show up for the GM, each entity only once.
+            sp::Bitset bodiless_added;
+            auto add_bodiless = [&](sp::ecs::Entity entity, sp::Transform& transform) {
+                if (entity.hasComponent<sp::Physics>() || bodiless_added.has(entity.getIndex()))
+                    return;
+                bodiless_added.set(entity.getIndex());
+                if (overlaps_box(transform, nullptr) && is_selectable(entity))
+                    entities.push_back(entity);
+            };
+            for(auto [entity, trace, transform] : sp::ecs::Query<RadarTrace, sp::Transform>())
+                add_bodiless(entity, transform);
+            for(auto [entity, mesh, transform] : sp::ecs::Query<MeshRenderComponent, sp::Transform>())
+                add_bodiless(entity, transform);
+            for(auto [entity, planet, transform] : sp::ecs::Query<PlanetRender, sp::Transform>())
+                add_bodiless(entity, transform);
+            for(auto [entity, nebula, transform] : sp::ecs::Query<NebulaRenderer, sp::Transform>())
+                add_bodiless(entity, transform);
+            for(auto [entity, zone, transform] : sp::ecs::Query<Zone, sp::Transform>())
+                add_bodiless(entity, transform);
             if (shift_down)
             {
                 for(auto e : entities)
@@ -20,6 +20,7 @@
 #include "script/gm.h"
 #include "script/component.h"
 #include "script/damageInfo.h"
+#include "script/missileProjectile.h"
 #include "script/scriptRandom.h"
 #include "components/impulse.h"
 #include "components/warpdrive.h"
@@ -628,6 +629,16 @@ static void luaApplyDamageToEntity(sp::ecs::Entity e, float amount, DamageInfo i
     DamageSystem::applyDamage(e, amount, info);
 }
 
+static MissileWeaponData::Projectile luaGetMissileProjectile(EMissileWeapons type)
+{
+    return MissileWeaponData::getDataFor(type).projectile;
+}
+
+static void luaSetMissileProjectile(EMissileWeapons type, MissileWeaponData::Projectile projectile)
+{
+    MissileWeaponData::setProjectileFor(type, projectile);
+}
+
 static int luaGetEEVersion()
 {
     return VERSION_NUMBER;
@@ -1190,6 +1201,17 @@ bool setupScriptEnvironment(sp::script::Environment& env)
     env.setGlobal("playSoundFile", &luaPlaySoundFile);
 
     env.setGlobal("applyDamageToEntity", &luaApplyDamageToEntity);
+    /// table getMissileProjectile(EMissileWeapons type)
+    /// Returns the projectile values of the given missile type, for a medium sized missile:
+    /// delayed_explode, damage_at_center, damage_at_edge, blast_range, damage_type, explosion_sfx,
+    /// gravity, electrical, biological, explode_on_timeout, avoid_delay, avoid_range, radar_icon
+    /// Example: getMissileProjectile("nuke").blast_range -- returns 1000
+    env.setGlobal("getMissileProjectile", &luaGetMissileProjectile);
+    /// void setMissileProjectile(EMissileWeapons type, table projectile)
+    /// Sets the projectile values used for all missiles of this type fired after this call.
+    /// Fields that are missing from the table are reset, so start from the table returned by getMissileProjectile().
+    /// Example: local p = getMissileProjectile("homing"); p.damage_at_center = 50; setMissileProjectile("homing", p)
+    env.setGlobal("setMissileProjectile", &luaSetMissileProjectile);
 
     env.setGlobal("commandTargetRotation", &luaCommandTargetRotation);
     env.setGlobal("commandImpulse", &luaCommandImpulse);
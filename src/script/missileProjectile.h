@@ -0,0 +1,87 @@
+#pragma once
+
+#include "missileWeaponData.h"
+#include "script/enum.h"
+#include "script/environment.h"
+
+
+namespace sp::script {
+template<> struct Convert<MissileWeaponData::Projectile> {
+    static int toLua(lua_State* L, const MissileWeaponData::Projectile& value) {
+        lua_newtable(L);
+        Convert<bool>::toLua(L, value.delayed_explode);
+        lua_setfield(L, -2, "delayed_explode");
+        Convert<float>::toLua(L, value.damage_at_center);
+        lua_setfield(L, -2, "damage_at_center");
+        Convert<float>::toLua(L, value.damage_at_edge);
+        lua_setfield(L, -2, "damage_at_edge");
+        Convert<float>::toLua(L, value.blast_range);
+        lua_setfield(L, -2, "blast_range");
+        Convert<DamageType>::toLua(L, value.damage_type);
+        lua_setfield(L, -2, "damage_type");
+        Convert<string>::toLua(L, value.explosion_sfx);
+        lua_setfield(L, -2, "explosion_sfx");
+        Convert<float>::toLua(L, value.radar_signature.x);
+        lua_setfield(L, -2, "gravity");
+        Convert<float>::toLua(L, value.radar_signature.y);
+        lua_setfield(L, -2, "electrical");
+        Convert<float>::toLua(L, value.radar_signature.z);
+        lua_setfield(L, -2, "biological");
+        Convert<bool>::toLua(L, value.explode_on_timeout);
+        lua_setfield(L, -2, "explode_on_timeout");
+        Convert<float>::toLua(L, value.avoid_delay);
+        lua_setfield(L, -2, "avoid_delay");
+        Convert<float>::toLua(L, value.avoid_range);
+        lua_setfield(L, -2, "avoid_range");
+        Convert<string>::toLua(L, value.radar_icon);
+        lua_setfield(L, -2, "radar_icon");
+        return 1;
+    }
+    static MissileWeaponData::Projectile fromLua(lua_State* L, int idx) {
+        MissileWeaponData::Projectile result{};
+        result.damage_type = DamageType::Kinetic;
+        if (lua_istable(L, idx)) {
+            if (lua_getfield(L, idx, "delayed_explode") != LUA_TNIL)
+                result.delayed_explode = Convert<bool>::fromLua(L, -1);
+            lua_pop(L, 1);
+            if (lua_getfield(L, idx, "damage_at_center") != LUA_TNIL)
+                result.damage_at_center = Convert<float>::fromLua(L, -1);
+            lua_pop(L, 1);
+            if (lua_getfield(L, idx, "damage_at_edge") != LUA_TNIL)
+                result.damage_at_edge = Convert<float>::fromLua(L, -1);
+            lua_pop(L, 1);
+            if (lua_getfield(L, idx, "blast_range") != LUA_TNIL)
+                result.blast_range = Convert<float>::fromLua(L, -1);
+            lua_pop(L, 1);
+            if (lua_getfield(L, idx, "damage_type") != LUA_TNIL)
+                result.damage_type = Convert<DamageType>::fromLua(L, -1);
+            lua_pop(L, 1);
+            if (lua_getfield(L, idx, "explosion_sfx") != LUA_TNIL)
+                result.explosion_sfx = Convert<string>::fromLua(L, -1);
+            lua_pop(L, 1);
+            if (lua_getfield(L, idx, "gravity") != LUA_TNIL)
+                result.radar_signature.x = Convert<float>::fromLua(L, -1);
+            lua_pop(L, 1);
+            if (lua_getfield(L, idx, "electrical") != LUA_TNIL)
+                result.radar_signature.y = Convert<float>::fromLua(L, -1);
+            lua_pop(L, 1);
+            if (lua_getfield(L, idx, "biological") != LUA_TNIL)
+                result.radar_signature.z = Convert<float>::fromLua(L, -1);
+            lua_pop(L, 1);
+            if (lua_getfield(L, idx, "explode_on_timeout") != LUA_TNIL)
+                result.explode_on_timeout = Convert<bool>::fromLua(L, -1);
+            lua_pop(L, 1);
+            if (lua_getfield(L, idx, "avoid_delay") != LUA_TNIL)
+                result.avoid_delay = Convert<float>::fromLua(L, -1);
+            lua_pop(L, 1);
+            if (lua_getfield(L, idx, "avoid_range") != LUA_TNIL)
+                result.avoid_range = Convert<float>::fromLua(L, -1);
+            lua_pop(L, 1);
+            if (lua_getfield(L, idx, "radar_icon") != LUA_TNIL)
+                result.radar_icon = Convert<string>::fromLua(L, -1);
+            lua_pop(L, 1);
+        }
+        return result;
+    }
+};
+}
@@ -30,7 +30,8 @@ namespace ShaderRegistry
             "shaders/objectShader:ILLUMINATION",
             "shaders/objectShader:SPECULAR",
             "shaders/objectShader:ILLUMINATION:SPECULAR",
-            "shaders/planet"
+            "shaders/planet",
+            "shaders/nebula"
         };
 
         std::array<const char*, Uniforms_t(Uniforms::Count)> uniform_names{
@@ -54,7 +55,8 @@ namespace ShaderRegistry
         std::array<const char*, Attributes_t(Attributes::Count)> attribute_names{
             "position",
             "texcoords",
-            "normal"
+            "normal",
+            "cloud_parameters"
         };
 
         std::array<std::tuple<Uniforms, int32_t>, 4> texture_units{
@@ -34,6 +34,7 @@ namespace ShaderRegistry
 		ObjectSpecular,
 		ObjectSpecularIllumination,
 		Planet,
+		Nebula,
 
 		Count
 	};
@@ -68,6 +69,7 @@ namespace ShaderRegistry
 		Position = 0,
 		Texcoords,
 		Normal,
+		CloudParameters,
 
 		Count
 	};
@@ -31,23 +31,52 @@ void BeamWeaponSystem::update(float delta)
     if (delta <= 0.0f) return;
 
     for(auto [entity, beamsys, target, transform, reactor, docking_port] : sp::ecs::Query<BeamWeaponSys, Target, sp::Transform, sp::ecs::optional<Reactor>, sp::ecs::optional<DockingPort>>()) {
-        auto warp = entity.getComponent<WarpDrive>();
+        float effectiveness = beamsys.getSystemEffectiveness();
+
+        //Resolve everything about the target once for all mounts of this ship.
+        bool engaged = false;
+        bool target_located = false;
+        glm::vec2 target_position{};
+        bool target_has_physics = false;
+        float target_size = 0.0f;
+        bool target_in_reach = false;
+        if (target.entity) {
+            auto warp = entity.getComponent<WarpDrive>();
+            engaged = Faction::getRelation(entity, target.entity) == FactionRelation::Enemy && (!warp || warp->current == 0.0f) && (!docking_port || docking_port->state == DockingPort::State::NotDocking);
+            if (engaged) {
+                if (auto target_transform = target.entity.getComponent<sp::Transform>()) {
+                    target_located = true;
+                    target_position = target_transform->getPosition();
+                }
+                if (auto physics = target.entity.getComponent<sp::Physics>()) {
+                    target_has_physics = true;
+                    target_size = physics->getSize().x;
+                }
+            }
+            if (target_located) {
+                //No mount can reach further than its turning range (range * 1.3) plus its offset from the ship center.
+                float reach = 0.0f;
+                for(auto& mount : beamsys.mounts)
+                    if (mount.range > 0.0f)
+                        reach = std::max(reach, mount.range * 1.3f + glm::length(glm::vec2(mount.position.x, mount.position.y)));
+                float distance = glm::length(target_position - transform.getPosition()) + target_size;
+                target_in_reach = distance < reach;
+            }
+        }
 
         for(auto& mount : beamsys.mounts) {
             if (mount.cooldown > 0.0f)
-                mount.cooldown -= delta * beamsys.getSystemEffectiveness();
+                mount.cooldown -= delta * effectiveness;
             if (!target.entity) continue;
 
             // Check on beam weapons only if we are on the server, have a target, and
             // not paused, and if the beams are cooled down or have a turret arc.
-            if (mount.range > 0.0f && Faction::getRelation(entity, target.entity) == FactionRelation::Enemy && delta > 0.0f && (!warp || warp->current == 0.0f) && (!docking_port || docking_port->state == DockingPort::State::NotDocking))
+            if (mount.range > 0.0f && engaged)
             {
-                if (auto target_transform = target.entity.getComponent<sp::Transform>()) {
+                if (target_in_reach) {
                     // Get the angle to the target.
-                    auto diff = target_transform->getPosition() - (transform.getPosition() + rotateVec2(glm::vec2(mount.position.x, mount.position.y), transform.getRotation()));
-                    float distance = glm::length(diff);
-                    if (auto physics = target.entity.getComponent<sp::Physics>())
-                        distance += physics->getSize().x;
+                    auto diff = target_position - (transform.getPosition() + rotateVec2(glm::vec2(mount.position.x, mount.position.y), transform.getRotation()));
+                    float distance = glm::length(diff) + target_size;
 
                     // We also only care if the target is within no more than its
                     // range * 1.3, which is when we want to start rotating the turret.
@@ -71,7 +100,7 @@ void BeamWeaponSystem::update(float delta)
                                     // ... rotate the turret's beam toward the target.
                                     if (fabsf(angle_diff) > 0)
                                     {
-                                        mount.direction += (angle_diff / fabsf(angle_diff)) * std::min(mount.turret_rotation_rate * beamsys.getSystemEffectiveness(), fabsf(angle_diff));
+                                        mount.direction += (angle_diff / fabsf(angle_diff)) * std::min(mount.turret_rotation_rate * effectiveness, fabsf(angle_diff));
                                     }
                                 // If the target is outside of the turret's arc ...
                                 } else {
@@ -81,7 +110,7 @@ void BeamWeaponSystem::update(float delta)
 
                                     if (fabsf(reset_angle_diff) > 0)
                                     {
-                                        mount.direction += (reset_angle_diff / fabsf(reset_angle_diff)) * std::min(mount.turret_rotation_rate * beamsys.getSystemEffectiveness(), fabsf(reset_angle_diff));
+                                        mount.direction += (reset_angle_diff / fabsf(reset_angle_diff)) * std::min(mount.turret_rotation_rate * effectiveness, fabsf(reset_angle_diff));
                                     }
                                 }
                             }
@@ -101,11 +130,11 @@ void BeamWeaponSystem::update(float delta)
 
                             mount.cooldown = mount.cycle_time; // Reset time of weapon
 
-                            auto hit_location = target_transform->getPosition();
+                            auto hit_location = target_position;
                             auto r = 100.0f;
-                            if (auto physics = target.entity.getComponent<sp::Physics>()) {
-                                hit_location -= glm::normalize(target_transform->getPosition() - transform.getPosition()) * physics->getSize().x;
-                                r = physics->getSize().x;
+                            if (target_has_physics) {
+                                hit_location -= glm::normalize(target_position - transform.getPosition()) * target_size;
+                                r = target_size;
                             }
 
                             auto e = sp::ecs::Entity::create();
@@ -120,7 +149,7 @@ void BeamWeaponSystem::update(float delta)
                             sfx.sound = "sfx/laser_fire.wav";
                             sfx.power = mount.damage / 6.0f;
                             {
-                                auto local_hit_location = hit_location - target_transform->getPosition();
+                                auto local_hit_location = hit_location - target_position;
                                 be.target_offset = glm::vec3(local_hit_location.x + random(-r/2.0f, r/2.0f), local_hit_location.y + random(-r/2.0f, r/2.0f), random(-r/4.0f, r/4.0f));
 
                                 auto shield = target.entity.getComponent<Shields>();
@@ -145,7 +174,7 @@ void BeamWeaponSystem::update(float delta)
 
                 if (fabsf(reset_angle_diff) > 0)
                 {
-                    mount.direction += (reset_angle_diff / fabsf(reset_angle_diff)) * std::min(mount.turret_rotation_rate * beamsys.getSystemEffectiveness(), fabsf(reset_angle_diff));
+                    mount.direction += (reset_angle_diff / fabsf(reset_angle_diff)) * std::min(mount.turret_rotation_rate * effectiveness, fabsf(reset_angle_diff));
                 }
             }
         }
@@ -0,0 +1,32 @@
+#include "systems/collisiondispatch.h"
+
+
+void CollisionDispatch::add(sp::CollisionHandler* handler, Filter filter)
+{
+    static CollisionDispatch* instance = nullptr;
+    if (!instance)
+    {
+        instance = new CollisionDispatch();
+        sp::CollisionSystem::addHandler(instance);
+    }
+    for(auto& entry : instance->entries)
+    {
+        if (entry.filter == filter)
+        {
+            entry.handlers.push_back(handler);
+            return;
+        }
+    }
+    instance->entries.push_back({filter, {handler}});
+}
+
+void CollisionDispatch::collision(sp::ecs::Entity a, sp::ecs::Entity b, float force)
+{
+    for(auto& entry : entries)
+    {
+        if (!entry.filter(a))
+            continue;
+        for(auto handler : entry.handlers)
+            handler->collision(a, b, force);
+    }
+}
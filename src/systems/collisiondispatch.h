@@ -0,0 +1,32 @@
+#pragma once
+
+#include <ecs/entity.h>
+#include "systems/collision.h"
+#include <vector>
+
+
+//Collision handlers registered here only receive the contacts where the first entity has one of the listed components,
+//  instead of every contact of the physics world. Asteroids and mines colliding with each other
+//  no longer reach the missile, docking and pickup handlers at all.
+class CollisionDispatch : public sp::CollisionHandler
+{
+public:
+    template<typename... COMPONENTS> static void addHandler(sp::CollisionHandler* handler)
+    {
+        add(handler, [](sp::ecs::Entity e) { return (e.hasComponent<COMPONENTS>() || ...); });
+    }
+
+    void collision(sp::ecs::Entity a, sp::ecs::Entity b, float force) override;
+private:
+    using Filter = bool(*)(sp::ecs::Entity);
+    struct Entry
+    {
+        Filter filter;
+        std::vector<sp::CollisionHandler*> handlers;
+    };
+
+    static void add(sp::CollisionHandler* handler, Filter filter);
+
+    //Handlers with the same filter share an entry, so each filter is tested once per contact.
+    std::vector<Entry> entries;
+};
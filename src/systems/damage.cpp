@@ -21,35 +21,86 @@ void DamageSystem::update(float delta)
     }
 }
 
+DamageSystem::BlastCandidates DamageSystem::blast_candidates;
+
+void DamageSystem::BlastCandidates::clear()
+{
+    entity.clear();
+    blast.clear();
+    position.clear();
+    rotation.clear();
+    radius.clear();
+    damage.clear();
+}
+
 void DamageSystem::damageArea(glm::vec2 position, float blast_range, float min_damage, float max_damage, const DamageInfo& info, float min_range)
 {
-    for(auto entity : sp::CollisionSystem::queryArea(position - glm::vec2(blast_range, blast_range), position + glm::vec2(blast_range, blast_range)))
+    damageArea({{position, blast_range, min_damage, max_damage, info, min_range}});
+}
+
+void DamageSystem::damageArea(const std::vector<Blast>& blasts)
+{
+    //Applying damage can run scripts that cause new blasts, those get their own candidate arrays.
+    BlastCandidates candidates;
+    std::swap(candidates, blast_candidates);
+
+    for(int b=0; b<int(blasts.size()); b++)
     {
-        auto transform = entity.getComponent<sp::Transform>();
-        if (!transform) continue;
-        auto physics = entity.getComponent<sp::Physics>();
-        if (!physics) continue;
-
-        float dist = glm::length(position - transform->getPosition()) - physics->getSize().x - min_range;
-        if (dist < 0) dist = 0;
-        if (dist < blast_range - min_range)
+        auto& blast = blasts[b];
+        for(auto entity : sp::CollisionSystem::queryArea(blast.position - glm::vec2(blast.blast_range, blast.blast_range), blast.position + glm::vec2(blast.blast_range, blast.blast_range)))
         {
-            applyDamage(entity, max_damage - (max_damage - min_damage) * dist / (blast_range - min_range), info);
+            auto transform = entity.getComponent<sp::Transform>();
+            if (!transform) continue;
+            auto physics = entity.getComponent<sp::Physics>();
+            if (!physics) continue;
+            candidates.entity.push_back(entity);
+            candidates.blast.push_back(b);
+            candidates.position.push_back(transform->getPosition());
+            candidates.rotation.push_back(transform->getRotation());
+            candidates.radius.push_back(physics->getSize().x);
         }
     }
+
+    size_t count = candidates.entity.size();
+    candidates.damage.resize(count);
+    for(size_t n=0; n<count; n++)
+    {
+        auto& blast = blasts[candidates.blast[n]];
+        float falloff_range = blast.blast_range - blast.min_range;
+        float dist = std::max(0.0f, glm::length(blast.position - candidates.position[n]) - candidates.radius[n] - blast.min_range);
+        candidates.damage[n] = dist < falloff_range ? blast.max_damage - (blast.max_damage - blast.min_damage) * dist / falloff_range : 0.0f;
+    }
+
+    for(size_t n=0; n<count; n++)
+    {
+        if (candidates.damage[n] <= 0.0f)
+            continue;
+        auto entity = candidates.entity[n];
+        if (!entity) //Destroyed by an earlier blast.
+            continue;
+        auto& blast = blasts[candidates.blast[n]];
+        float angle = angleDifference(candidates.rotation[n], vec2ToAngle(blast.info.location - candidates.position[n]));
+        applyDamageAtAngle(entity, candidates.damage[n], blast.info, angle);
+    }
+
+    candidates.clear();
+    std::swap(candidates, blast_candidates);
 }
 
 void DamageSystem::applyDamage(sp::ecs::Entity entity, float amount, const DamageInfo& info)
+{
+    float angle = 0;
+    if (auto transform = entity.getComponent<sp::Transform>())
+        angle = angleDifference(transform->getRotation(), vec2ToAngle(info.location - transform->getPosition()));
+    applyDamageAtAngle(entity, amount, info, angle);
+}
+
+void DamageSystem::applyDamageAtAngle(sp::ecs::Entity entity, float amount, const DamageInfo& info, float angle)
 {
     auto shields = entity.getComponent<Shields>();
     if (shields && shields->active && !shields->entries.empty()) {
-        auto transform = entity.getComponent<sp::Transform>();
-        float angle = 0;
-        if (transform) {
-            angle = angleDifference(transform->getRotation(), vec2ToAngle(info.location - transform->getPosition()));
-            if (angle < 0)
-                angle += 360.0f;
-        }
+        if (angle < 0)
+            angle += 360.0f;
         float arc = 360.0f / float(shields->entries.size());
         int shield_index = int((angle + arc / 2.0f) / arc);
         shield_index %= shields->entries.size();
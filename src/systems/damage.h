@@ -3,6 +3,7 @@
 #include "ecs/entity.h"
 #include "ecs/system.h"
 #include "components/shipsystem.h"
+#include <vector>
 
 
 enum class DamageType
@@ -34,12 +35,41 @@ public:
 class DamageSystem : public sp::ecs::System
 {
 public:
+    struct Blast
+    {
+        glm::vec2 position;
+        float blast_range;
+        float min_damage;
+        float max_damage;
+        DamageInfo info;
+        float min_range;
+    };
+
     void update(float delta) override;
 
     static void damageArea(glm::vec2 position, float blast_range, float min_damage, float max_damage, const DamageInfo& info, float min_range);
+    //Resolve a set of simultaneous blasts in one pass. All entities in range of any blast are gathered first,
+    //  then the damage of every blast to every entity is calculated, and only then is the damage applied.
+    static void damageArea(const std::vector<Blast>& blasts);
     static void applyDamage(sp::ecs::Entity entity, float amount, const DamageInfo& info);
 
 private:
+    //Entities in range of a blast, gathered as separate arrays so the falloff is calculated in a tight loop.
+    struct BlastCandidates
+    {
+        std::vector<sp::ecs::Entity> entity;
+        std::vector<int> blast;
+        std::vector<glm::vec2> position;
+        std::vector<float> rotation;
+        std::vector<float> radius;
+        std::vector<float> damage;
+
+        void clear();
+    };
+    static BlastCandidates blast_candidates;
+
+    //shield_angle is the angle of the damage location, relative to the rotation of the entity.
+    static void applyDamageAtAngle(sp::ecs::Entity entity, float amount, const DamageInfo& info, float shield_angle);
     static void takeHullDamage(sp::ecs::Entity entity, float amount, const DamageInfo& info);
     static void destroyedByDamage(sp::ecs::Entity entity, const DamageInfo& info);
 };
@@ -14,7 +14,7 @@
 
 DockingSystem::DockingSystem()
 {
-    sp::CollisionSystem::addHandler(this);
+    CollisionDispatch::addHandler<DockingPort>(this);
 }
 
 void DockingSystem::update(float delta)
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "ecs/system.h"
-#include "systems/collision.h"
+#include "systems/collisiondispatch.h"
 
 
 class DockingSystem : public sp::ecs::System, public sp::CollisionHandler
@@ -9,6 +9,7 @@
 #include "random.h"
 #include "menus/luaConsole.h"
 #include <glm/gtx/norm.hpp>
+#include <glm/exponential.hpp>
 
 
 void GravitySystem::update(float delta)
@@ -17,10 +18,13 @@ void GravitySystem::update(float delta)
     static constexpr float wormhole_target_spread = 500.0f;
     if (delta <= 0.0f) return;
 
+    pulls.clear();
+    pull_index.clear();
     for(auto [source, grav, source_transform] : sp::ecs::Query<Gravity, sp::Transform>()) {
         for(auto target : sp::CollisionSystem::queryArea(source_transform.getPosition() - glm::vec2(grav.range, grav.range), source_transform.getPosition() + glm::vec2(grav.range, grav.range))) {
             if (target == source) continue;
             auto tt = target.getComponent<sp::Transform>();
+            if (!tt) continue;
             auto diff = source_transform.getPosition() - tt->getPosition();
             float dist2 = std::max(1.0f, glm::length2(diff));
             if (dist2 > grav.range*grav.range)
@@ -28,7 +32,12 @@ void GravitySystem::update(float delta)
             float force = (grav.range * grav.range * grav.force) / dist2;
             if (force >= max_force)
                 force = max_force;
-            tt->setPosition(tt->getPosition() + diff / std::sqrt(dist2) * delta * force);
+
+            auto [it, inserted] = pull_index.emplace(target.getIndex(), pulls.size());
+            if (inserted)
+                pulls.push_back({target, {0.0f, 0.0f}, false});
+            auto& pull = pulls[it->second];
+            pull.offset += diff * (glm::inversesqrt(dist2) * delta * force);
 
             if (grav.wormhole_target.x || grav.wormhole_target.y) {
                 /*TODO
@@ -41,6 +50,7 @@ void GravitySystem::update(float delta)
                 {
                     if (game_server) {
                         tt->setPosition( (grav.wormhole_target + glm::vec2(random(-wormhole_target_spread, wormhole_target_spread), random(-wormhole_target_spread, wormhole_target_spread))));
+                        pull.teleported = true;
                         if (grav.on_teleportation)
                         {
                             LuaConsole::checkResult(grav.on_teleportation.call<void>(source, target));
@@ -62,7 +72,7 @@ void GravitySystem::update(float delta)
                     {
                         if (!target.hasComponent<Hull>() || target.getComponent<Hull>()->allow_destruction)
                             target.destroy();
-                        return;
+                        continue;
                     }
                 }
                 if (force > 100.0f)
@@ -70,6 +80,13 @@ void GravitySystem::update(float delta)
             }
         }
     }
+
+    //Apply the summed pull of all wells with a single position update per entity.
+    for(auto& pull : pulls) {
+        if (pull.teleported || !pull.entity) continue;
+        if (auto transform = pull.entity.getComponent<sp::Transform>())
+            transform->setPosition(transform->getPosition() + pull.offset);
+    }
 }
 
 void GravitySystem::renderOnRadar(sp::RenderTarget& renderer, sp::ecs::Entity e, glm::vec2 screen_position, float scale, float rotation, Gravity& component)
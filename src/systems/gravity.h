@@ -3,6 +3,8 @@
 #include "ecs/system.h"
 #include "systems/radar.h"
 #include "components/gravity.h"
+#include <unordered_map>
+#include <vector>
 
 
 class GravitySystem : public sp::ecs::System, public RenderRadarInterface<Gravity, 12, RadarRenderSystem::FlagGM>
@@ -10,4 +12,14 @@ class GravitySystem : public sp::ecs::System, public RenderRadarInterface<Gravit
 public:
     void update(float delta) override;
     void renderOnRadar(sp::RenderTarget& renderer, sp::ecs::Entity e, glm::vec2 screen_position, float scale, float rotation, Gravity& component) override;
+private:
+    //Summed pull of all gravity wells on a single entity, applied once at the end of the update.
+    struct Pull
+    {
+        sp::ecs::Entity entity;
+        glm::vec2 offset;
+        bool teleported;
+    };
+    std::vector<Pull> pulls;
+    std::unordered_map<uint32_t, size_t> pull_index; //Entity index to index in pulls.
 };
@@ -3,39 +3,26 @@
 #include "ecs/query.h"
 #include "multiplayer_server.h"
 #include "random.h"
+#include <algorithm>
 
-#include <glm/gtx/hash.hpp>
-#include "astar.h"
 
-static InternalRooms* pathfind_rooms;
+std::vector<InternalCrewSystem::ShipCrew> InternalCrewSystem::ship_crews;
 
-static std::vector<std::pair<glm::ivec2, float>> astarGetNeighbors(glm::ivec2 pos) {
-    std::vector<std::pair<glm::ivec2, float>> result;
-    for(auto& room : pathfind_rooms->rooms) {
-        if (pos.x >= room.position.x && pos.x < room.position.x + room.size.x && pos.y >= room.position.y && pos.y < room.position.y + room.size.y) {
-            if (pos.x > room.position.x) result.push_back({pos + glm::ivec2{-1, 0}, 1.0f});
-            if (pos.x < room.position.x + room.size.x - 1) result.push_back({pos + glm::ivec2{1, 0}, 1.0f});
-            if (pos.y > room.position.y) result.push_back({pos + glm::ivec2{0, -1}, 1.0f});
-            if (pos.y < room.position.y + room.size.y - 1) result.push_back({pos + glm::ivec2{0, 1}, 1.0f});
-            break;
-        }
-    }
-    for(auto& door : pathfind_rooms->doors) {
-        if (door.horizontal) {
-            if (door.position == pos) result.push_back({pos + glm::ivec2{0, -1}, 1.1f});
-            if (door.position == pos + glm::ivec2{0, 1}) result.push_back({pos + glm::ivec2{0, 1}, 1.1f});
-        } else {
-            if (door.position == pos) result.push_back({pos + glm::ivec2{-1, 0}, 1.1f});
-            if (door.position == pos + glm::ivec2{1, 0}) result.push_back({pos + glm::ivec2{1, 0}, 1.1f});
-        }
-    }
-    return result;
+const std::vector<sp::ecs::Entity>& InternalCrewSystem::getCrew(sp::ecs::Entity ship)
+{
+    static const std::vector<sp::ecs::Entity> no_crew;
+    for(auto& sc : ship_crews)
+        if (sc.ship == ship)
+            return sc.crew;
+    return no_crew;
 }
 
-static float astarGetDistance(glm::ivec2 a, glm::ivec2 b) { return glm::length(glm::vec2(b - a)); }
-
 void InternalCrewSystem::update(float delta)
 {
+    for(auto& sc : ship_crews)
+        sc.crew.clear();
+    ship_crews.erase(std::remove_if(ship_crews.begin(), ship_crews.end(), [](const ShipCrew& sc) { return !sc.ship; }), ship_crews.end());
+
     for(auto [entity, ic] : sp::ecs::Query<InternalCrew>()) {
         if (game_server && !ic.ship)
         {
@@ -52,6 +39,14 @@ void InternalCrewSystem::update(float delta)
             continue;
         }
 
+        auto sc = std::find_if(ship_crews.begin(), ship_crews.end(), [&ic](const ShipCrew& other) { return other.ship == ic.ship; });
+        if (sc == ship_crews.end())
+        {
+            ship_crews.push_back({ic.ship, {}});
+            sc = ship_crews.end() - 1;
+        }
+        sc->crew.push_back(entity);
+
         if (ic.position.x < -0.5f)
         {
             int n=irandom(0, ir->rooms.size() - 1);
@@ -69,14 +64,13 @@ void InternalCrewSystem::update(float delta)
                 ic.action_delay = 1.0f / ic.move_speed;
                 if (pos != ic.target_position)
                 {
-                    pathfind_rooms = ir;
-                    auto path = astar(pos, ic.target_position, astarGetNeighbors, astarGetDistance);
-                    if (path.size() > 0) {
+                    auto next = ir->getNextStep(pos, ic.target_position);
+                    if (next != pos) {
                         ic.action = InternalCrew::Action::Move;
-                        if (path[0].x > pos.x) ic.direction = InternalCrew::Direction::Right;
-                        if (path[0].x < pos.x) ic.direction = InternalCrew::Direction::Left;
-                        if (path[0].y > pos.y) ic.direction = InternalCrew::Direction::Down;
-                        if (path[0].y < pos.y) ic.direction = InternalCrew::Direction::Up;
+                        if (next.x > pos.x) ic.direction = InternalCrew::Direction::Right;
+                        if (next.x < pos.x) ic.direction = InternalCrew::Direction::Left;
+                        if (next.y > pos.y) ic.direction = InternalCrew::Direction::Down;
+                        if (next.y < pos.y) ic.direction = InternalCrew::Direction::Up;
                     }
                 }
                 ic.position = glm::vec2{pos.x, pos.y};
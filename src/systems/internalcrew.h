@@ -1,10 +1,22 @@
 #pragma once
 
 #include "ecs/system.h"
+#include "ecs/entity.h"
+#include <vector>
 
 
 class InternalCrewSystem : public sp::ecs::System
 {
 public:
     void update(float delta) override;
+
+    // Crew members of a ship, as found during the last update.
+    static const std::vector<sp::ecs::Entity>& getCrew(sp::ecs::Entity ship);
+private:
+    struct ShipCrew
+    {
+        sp::ecs::Entity ship;
+        std::vector<sp::ecs::Entity> crew;
+    };
+    static std::vector<ShipCrew> ship_crews;
 };
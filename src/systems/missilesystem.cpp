@@ -20,7 +20,7 @@
 
 MissileSystem::MissileSystem()
 {
-    sp::CollisionSystem::addHandler(this);
+    CollisionDispatch::addHandler<DelayedExplodeOnTouch, ExplodeOnTouch>(this);
 }
 
 void MissileSystem::update(float delta)
@@ -110,7 +110,7 @@ void MissileSystem::update(float delta)
             deot.delay -= delta;
             if (deot.delay >= 0.0f) continue;
 
-            explode(entity, {}, deot);
+            explode(entity, {}, deot, &blasts);
         }
     }
 
@@ -121,13 +121,18 @@ void MissileSystem::update(float delta)
             if (lifetime.lifetime <= 0.0f) {
                 if (entity.hasComponent<ExplodeOnTimeout>()) {
                     if (auto eot = entity.getComponent<ExplodeOnTouch>()) {
-                        explode(entity, {}, *eot);
+                        explode(entity, {}, *eot, &blasts);
                     }
                 }
                 entity.destroy();
             }
         }
     }
+
+    if (!blasts.empty()) {
+        DamageSystem::damageArea(blasts);
+        blasts.clear();
+    }
 }
 
 void MissileSystem::collision(sp::ecs::Entity a, sp::ecs::Entity b, float force)
@@ -157,13 +162,17 @@ void MissileSystem::renderOnRadar(sp::RenderTarget& renderer, sp::ecs::Entity e,
     renderer.drawCircleOutline(screen_position, r * scale, 3.0, component.triggered ? glm::u8vec4(255, 0, 0, 128) : glm::u8vec4(255, 255, 255, 128));
 }
 
-void MissileSystem::explode(sp::ecs::Entity source, sp::ecs::Entity target, ExplodeOnTouch& eot)
+void MissileSystem::explode(sp::ecs::Entity source, sp::ecs::Entity target, ExplodeOnTouch& eot, std::vector<DamageSystem::Blast>* blasts)
 {
     auto transform = source.getComponent<sp::Transform>();
     if (!transform) return;
     DamageInfo info(eot.owner, eot.damage_type, transform->getPosition());
     if (eot.blast_range > 100.0f || !target) {
-        DamageSystem::damageArea(transform->getPosition(), eot.blast_range, eot.damage_at_edge, eot.damage_at_center, info, eot.blast_range / 2);
+        DamageSystem::Blast blast{transform->getPosition(), eot.blast_range, eot.damage_at_edge, eot.damage_at_center, info, eot.blast_range / 2};
+        if (blasts)
+            blasts->push_back(blast);
+        else
+            DamageSystem::damageArea({blast});
     } else {
         DamageSystem::applyDamage(target, eot.damage_at_center, info);
     }
@@ -235,132 +244,76 @@ void MissileSystem::fire(sp::ecs::Entity source, MissileTubes::MountPoint& tube,
 
 void MissileSystem::spawnProjectile(sp::ecs::Entity source, MissileTubes::MountPoint& tube, float target_angle, sp::ecs::Entity target)
 {
+    if (tube.type_loaded < 0 || tube.type_loaded >= MW_Count)
+        return;
     auto source_transform = source.getComponent<sp::Transform>();
     if (!source_transform) return;
     auto fireLocation = source_transform->getPosition() + rotateVec2(glm::vec2(tube.position), source_transform->getRotation());
     auto category_modifier = MissileWeaponData::convertSizeToCategoryModifier(tube.size);
-
-    sp::ecs::Entity missile;
-    switch(tube.type_loaded)
-    {
-    case MW_Homing:
-        {
-            missile = sp::ecs::Entity::create();
-            auto& mc = missile.addComponent<ExplodeOnTouch>();
-            mc.owner = source;
-            mc.damage_at_center = 35 * category_modifier;
-            mc.damage_at_edge = 5 * category_modifier;
-            mc.blast_range = 30 * category_modifier;
-            missile.addComponent<RawRadarSignatureInfo>(0.0f, 0.1f, 0.2f);
-        }
-        break;
-    case MW_Nuke:
-        {
-            missile = sp::ecs::Entity::create();
-            auto& mc = missile.addComponent<ExplodeOnTouch>();
-            mc.owner = source;
-            mc.damage_at_center = 160.0f * category_modifier;
-            mc.damage_at_edge = 30.0f * category_modifier;
-            mc.blast_range = 1000.0f * category_modifier;
-            mc.explosion_sfx = "sfx/nuke_explosion.wav";
-            missile.addComponent<RawRadarSignatureInfo>(0.0f, 0.7f, 0.1f);
-            missile.addComponent<DelayedAvoidObject>(10.0f, 1000.0f);
-            missile.addComponent<ExplodeOnTimeout>();
-        }
-        break;
-    case MW_Mine:
-        {
-            missile = sp::ecs::Entity::create();
-            auto& mc = missile.addComponent<DelayedExplodeOnTouch>();
-            mc.delay = 1.0f;
-            mc.owner = source;
-            mc.damage_at_center = 160.0f * category_modifier;
-            mc.damage_at_edge = 30.0f * category_modifier;
-            mc.blast_range = 1000.0f * category_modifier;
-            missile.addComponent<RawRadarSignatureInfo>(0.0f, 0.05f, 0.0f);
-        }
-        break;
-    case MW_HVLI:
-        {
-            missile = sp::ecs::Entity::create();
-            auto& mc = missile.addComponent<ExplodeOnTouch>();
-            mc.owner = source;
-            mc.damage_at_center = 10.0f * category_modifier;
-            mc.damage_at_edge = 10.0f * category_modifier;
-            mc.blast_range = 20.0f * category_modifier;
-            missile.addComponent<RawRadarSignatureInfo>(0.1f, 0.0f, 0.0f);
-        }
-        break;
-    case MW_EMP:
-        {
-            missile = sp::ecs::Entity::create();
-            auto& mc = missile.addComponent<ExplodeOnTouch>();
-            mc.owner = source;
-            mc.damage_at_center = 160.0f * category_modifier;
-            mc.damage_at_edge = 30.0f * category_modifier;
-            mc.blast_range = 1000.0f * category_modifier;
-            mc.damage_type = DamageType::EMP;
-            missile.addComponent<RawRadarSignatureInfo>(0.0f, 1.0f, 0.0f);
-            missile.addComponent<ExplodeOnTimeout>();
-        }
-        break;
-    default:
-        break;
+    auto& mwd = MissileWeaponData::getDataFor(tube.type_loaded);
+    auto& archetype = mwd.projectile;
+
+    auto missile = sp::ecs::Entity::create();
+    ExplodeOnTouch& mc = archetype.delayed_explode ? missile.addComponent<DelayedExplodeOnTouch>() : missile.addComponent<ExplodeOnTouch>();
+    mc.owner = source;
+    mc.damage_at_center = archetype.damage_at_center * category_modifier;
+    mc.damage_at_edge = archetype.damage_at_edge * category_modifier;
+    mc.blast_range = archetype.blast_range * category_modifier;
+    mc.damage_type = archetype.damage_type;
+    mc.explosion_sfx = archetype.explosion_sfx;
+    missile.addComponent<RawRadarSignatureInfo>(archetype.radar_signature.x, archetype.radar_signature.y, archetype.radar_signature.z);
+    if (archetype.avoid_range > 0.0f)
+        missile.addComponent<DelayedAvoidObject>(archetype.avoid_delay, archetype.avoid_range);
+    if (archetype.explode_on_timeout)
+        missile.addComponent<ExplodeOnTimeout>();
+
+    auto& physics = missile.addComponent<sp::Physics>();
+    if (archetype.delayed_explode)
+        physics.setCircle(sp::Physics::Type::Sensor, archetype.blast_range * 0.6f);
+    else
+        physics.setRectangle(sp::Physics::Type::Sensor, {10, 30});
+
+    auto& mf = missile.addComponent<MissileFlight>();
+    mf.speed = mwd.speed / category_modifier;
+    if (archetype.delayed_explode)
+        mf.timeout = mwd.lifetime;
+    if (mwd.homing_range > 0.0f) {
+        auto& mh = missile.addComponent<MissileHoming>();
+        mh.range = mwd.homing_range;
+        mh.target = target;
+        mh.target_angle = target_angle;
+        mh.turn_rate = mwd.turnrate / category_modifier;
     }
 
-    if (missile) {
-        auto& physics = missile.addComponent<sp::Physics>();
-        if (tube.type_loaded == MW_Mine)
-            physics.setCircle(sp::Physics::Type::Sensor, 1000.0f * 0.6f);
-        else
-            physics.setRectangle(sp::Physics::Type::Sensor, {10, 30});
-
-        auto& mwd = MissileWeaponData::getDataFor(tube.type_loaded);
-        auto& mf = missile.addComponent<MissileFlight>();
-        mf.speed = mwd.speed / category_modifier;
-        if (tube.type_loaded == MW_Mine)
-            mf.timeout = mwd.lifetime;
-        if (mwd.homing_range > 0.0f) {
-            auto& mh = missile.addComponent<MissileHoming>();
-            mh.range = mwd.homing_range;
-            mh.target = target;
-            mh.target_angle = target_angle;
-            mh.turn_rate = mwd.turnrate / category_modifier;
-        }
-
-        if (auto f = source.getComponent<Faction>())
-            missile.addComponent<Faction>().entity = f->entity;
-        auto& t = missile.addComponent<sp::Transform>();
-        t.setPosition(fireLocation);
-        t.setRotation(source_transform->getRotation() + tube.direction);
-        auto cpe = missile.addComponent<ConstantParticleEmitter>();
-        if (tube.type_loaded == MW_Mine) {
-            cpe.travel_random_range = 100.0f;
-            cpe.start_color = {1, 1, 1};
-            cpe.end_color = {0, 0, 1};
-            cpe.interval = 0.4;
-            cpe.start_size = 30.0f;
-            cpe.end_size = 0.0f;
-            cpe.life_time = 10.0f;
-        }
-
-        missile.addComponent<LifeTime>().lifetime = mwd.lifetime / category_modifier;
+    if (auto f = source.getComponent<Faction>())
+        missile.addComponent<Faction>().entity = f->entity;
+    auto& t = missile.addComponent<sp::Transform>();
+    t.setPosition(fireLocation);
+    t.setRotation(source_transform->getRotation() + tube.direction);
+    auto& cpe = missile.addComponent<ConstantParticleEmitter>();
+    if (archetype.delayed_explode) {
+        cpe.travel_random_range = 100.0f;
+        cpe.start_color = {1, 1, 1};
+        cpe.end_color = {0, 0, 1};
+        cpe.interval = 0.4;
+        cpe.start_size = 30.0f;
+        cpe.end_size = 0.0f;
+        cpe.life_time = 10.0f;
+    }
 
-        if (tube.type_loaded != MW_Mine) {
-            auto& dbad = missile.addComponent<DestroyedByAreaDamage>();
-            dbad.damaged_by_flags = (1 << int(DamageType::EMP)) | (1 << int(DamageType::Energy));
-        }
+    missile.addComponent<LifeTime>().lifetime = mwd.lifetime / category_modifier;
 
-        auto& trace = missile.addComponent<RadarTrace>();
-        if (tube.type_loaded == MW_Mine)
-            trace.icon = "radar/mine.png";
-        else
-            trace.icon = "radar/missile.png";
-        trace.radius = 32.0f;
-        trace.max_size = trace.min_size = 32 * (0.25f + 0.25f * category_modifier);
-        trace.flags = RadarTrace::Rotate;
-        trace.color = mwd.color;
+    if (!archetype.delayed_explode) {
+        auto& dbad = missile.addComponent<DestroyedByAreaDamage>();
+        dbad.damaged_by_flags = (1 << int(DamageType::EMP)) | (1 << int(DamageType::Energy));
     }
+
+    auto& trace = missile.addComponent<RadarTrace>();
+    trace.icon = archetype.radar_icon;
+    trace.radius = 32.0f;
+    trace.max_size = trace.min_size = 32 * (0.25f + 0.25f * category_modifier);
+    trace.flags = RadarTrace::Rotate;
+    trace.color = mwd.color;
 }
 
 static float calculateTurnAngle(glm::vec2 aim_position, float turn_direction, float turn_radius)
@@ -3,7 +3,7 @@
 #include "ecs/system.h"
 #include "components/missile.h"
 #include "components/missiletubes.h"
-#include "systems/collision.h"
+#include "systems/collisiondispatch.h"
 #include "systems/radar.h"
 
 
@@ -25,6 +25,9 @@ public:
     static float calculateFiringSolution(sp::ecs::Entity source, const MissileTubes::MountPoint& tube, sp::ecs::Entity target);
 
 private:
-    static void explode(sp::ecs::Entity source, sp::ecs::Entity target, ExplodeOnTouch& eot);
+    std::vector<DamageSystem::Blast> blasts;
+
+    //When blasts is given, area damage is added to it instead of applied, so simultaneous explosions are resolved in one pass.
+    static void explode(sp::ecs::Entity source, sp::ecs::Entity target, ExplodeOnTouch& eot, std::vector<DamageSystem::Blast>* blasts = nullptr);
     static void spawnProjectile(sp::ecs::Entity source, MissileTubes::MountPoint& tube, float angle, sp::ecs::Entity target);
 };
@@ -5,6 +5,11 @@
 #include "ecs/query.h"
 #include "multiplayer_server.h"
 
+PickupSystem::PickupSystem()
+{
+    CollisionDispatch::addHandler<PickupCallback, CollisionCallback>(this);
+}
+
 void PickupSystem::update(float delta)
 {
 }
@@ -13,6 +13,31 @@ sp::Bitset RadarRenderSystem::visible_objects;
 std::vector<RadarRenderSystem::Handler> RadarRenderSystem::handlers;
 
 
+static const string unscanned_ship_icon = "radar/ship.png";
+
+glm::u8vec4 BasicRadarRendering::getFactionColor(sp::ecs::Entity entity)
+{
+    auto faction = entity.getComponent<Faction>();
+    sp::ecs::Entity faction_entity = faction ? faction->entity : sp::ecs::Entity{};
+    for(auto& entry : palette)
+        if (entry.faction == faction_entity)
+            return entry.color;
+
+    auto color = Faction::getInfo(entity).gm_color;
+    if (my_spaceship)
+    {
+        auto relation = Faction::getRelation(my_spaceship, entity);
+        if (relation == FactionRelation::Enemy)
+            color = glm::u8vec4(255, 0, 0, 255);
+        else if (relation == FactionRelation::Friendly)
+            color = glm::u8vec4(128, 255, 128, 255);
+        else
+            color = glm::u8vec4(128, 128, 255, 255);
+    }
+    palette.push_back({faction_entity, color});
+    return color;
+}
+
 void BasicRadarRendering::renderOnRadar(sp::RenderTarget& renderer, sp::ecs::Entity entity, glm::vec2 screen_position, float scale, float rotation, RadarTrace& trace)
 {
     if ((RadarRenderSystem::current_flags & RadarRenderSystem::FlagLongRange) && !(trace.flags & RadarTrace::LongRange))
@@ -22,32 +47,25 @@ void BasicRadarRendering::renderOnRadar(sp::RenderTarget& renderer, sp::ecs::Ent
     auto size = trace.radius * scale * 2.0f;
     size = std::clamp(size, trace.min_size, trace.max_size);
 
+    auto scan_state = (scanstate && my_spaceship) ? scanstate->getStateFor(my_spaceship) : ScanState::State::FullScan;
     auto color = trace.color;
     if (trace.flags & RadarTrace::ColorByFaction) {
-        color = Faction::getInfo(entity).gm_color;
-        if (my_spaceship)
-        {
-            if (entity == my_spaceship)
-                color = glm::u8vec4(192, 192, 255, 255);
-            else if (scanstate && scanstate->getStateFor(my_spaceship) == ScanState::State::NotScanned)
-                color = glm::u8vec4(192, 192, 192, 255);
-            else if (Faction::getRelation(my_spaceship, entity) == FactionRelation::Enemy)
-                color = glm::u8vec4(255, 0, 0, 255);
-            else if (Faction::getRelation(my_spaceship, entity) == FactionRelation::Friendly)
-                color = glm::u8vec4(128, 255, 128, 255);
-            else
-                color = glm::u8vec4(128, 128, 255, 255);
-        }
+        if (my_spaceship && entity == my_spaceship)
+            color = glm::u8vec4(192, 192, 255, 255);
+        else if (my_spaceship && scanstate && scan_state == ScanState::State::NotScanned)
+            color = glm::u8vec4(192, 192, 192, 255);
+        else
+            color = getFactionColor(entity);
     }
-    auto icon = trace.icon;
+    auto icon = &trace.icon;
     if ((trace.flags & RadarTrace::ArrowIfNotScanned) && scanstate && my_spaceship)
     {
         // If the object is a ship that hasn't been scanned, draw the default icon.
         // Otherwise, draw the ship-specific icon.
-        switch(scanstate->getStateFor(my_spaceship)) {
+        switch(scan_state) {
         case ScanState::State::NotScanned:
         case ScanState::State::FriendOrFoeIdentified:
-            icon = "radar/ship.png";
+            icon = &unscanned_ship_icon;
             break;
         default:
             break;
@@ -55,13 +73,18 @@ void BasicRadarRendering::renderOnRadar(sp::RenderTarget& renderer, sp::ecs::Ent
     }
 
     if ((trace.flags & RadarTrace::BlendAdd) && (trace.flags & RadarTrace::Rotate))
-        renderer.drawRotatedSpriteBlendAdd(icon, screen_position, size, rotation);
+        renderer.drawRotatedSpriteBlendAdd(*icon, screen_position, size, rotation);
     else if (trace.flags & RadarTrace::BlendAdd)
-        renderer.drawRotatedSpriteBlendAdd(icon, screen_position, size, 0);
+        renderer.drawRotatedSpriteBlendAdd(*icon, screen_position, size, 0);
     else if (trace.flags & RadarTrace::Rotate)
-        renderer.drawRotatedSprite(icon, screen_position, size, rotation, color);
+        renderer.drawRotatedSprite(*icon, screen_position, size, rotation, color);
     else
-        renderer.drawSprite(icon, screen_position, size, color);
+        renderer.drawSprite(*icon, screen_position, size, color);
+}
+
+void BasicRadarRendering::flushRadar(sp::RenderTarget& renderer)
+{
+    palette.clear();
 }
 
 void BasicRadarRendering::renderOnRadar(sp::RenderTarget& renderer, sp::ecs::Entity entity, glm::vec2 screen_position, float scale, float rotation, CallSign& callsign)
@@ -12,6 +12,8 @@ template<typename T, int PRIO, int FLAGS> class RenderRadarInterface {
 public:
     RenderRadarInterface();
     virtual void renderOnRadar(sp::RenderTarget& renderer, sp::ecs::Entity e, glm::vec2 screen_position, float scale, float rotation, T& component) = 0;
+    // Called after all entities of this handler have been passed to renderOnRadar, for handlers that keep per pass state.
+    virtual void flushRadar(sp::RenderTarget& renderer) {}
 };
 
 class RadarRenderSystem {
@@ -27,6 +29,7 @@ public:
                     radar_position += radar_screen_center;
                     rr->renderOnRadar(renderer, entity, radar_position, current_scale, transform.getRotation() + current_rotation_offset, component);
                 }
+                rr->flushRadar(renderer);
             }
         });
         std::sort(handlers.begin(), handlers.end(), [](const Handler& a, const Handler& b) {
@@ -82,4 +85,14 @@ public:
 
     void renderOnRadar(sp::RenderTarget& renderer, sp::ecs::Entity e, glm::vec2 screen_position, float scale, float rotation, RadarTrace& component) override;
     void renderOnRadar(sp::RenderTarget& renderer, sp::ecs::Entity e, glm::vec2 screen_position, float scale, float rotation, CallSign& component) override;
+    void flushRadar(sp::RenderTarget& renderer) override;
+private:
+    // Color per faction as seen from my_spaceship, filled on first use and cleared after each pass.
+    struct PaletteEntry
+    {
+        sp::ecs::Entity faction;
+        glm::u8vec4 color;
+    };
+    std::vector<PaletteEntry> palette;
+    glm::u8vec4 getFactionColor(sp::ecs::Entity entity);
 };
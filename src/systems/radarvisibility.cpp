@@ -0,0 +1,122 @@
+#include "systems/radarvisibility.h"
+#include "systems/radarblock.h"
+#include "systems/collision.h"
+#include "components/collision.h"
+#include "components/faction.h"
+#include "components/radar.h"
+#include "components/radarblock.h"
+#include "ecs/query.h"
+#include <glm/gtx/norm.hpp>
+#include <algorithm>
+
+
+std::vector<RadarVisibilitySystem::Entry> RadarVisibilitySystem::entries;
+
+RadarVisibilitySystem::RadarVisibilitySystem()
+{
+    refresh_timer.repeat(refresh_interval);
+}
+
+void RadarVisibilitySystem::update(float delta)
+{
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [](Entry& entry) { return entry.unused_timer.isExpired(); }), entries.end());
+
+    if (!refresh_timer.isExpired())
+        return;
+    for(auto& entry : entries)
+        refresh(entry);
+}
+
+const sp::Bitset& RadarVisibilitySystem::getVisibleObjects(Mode mode, sp::ecs::Entity observer)
+{
+    sp::ecs::Entity key = observer;
+    if (mode == Mode::FriendlyShortRange)
+    {
+        //Friendliness only depends on the faction of the observer, so all ships of a faction share one result.
+        auto faction = observer.getComponent<Faction>();
+        key = faction ? faction->entity : sp::ecs::Entity{};
+    }
+
+    for(auto& entry : entries)
+    {
+        if (entry.mode == mode && entry.key == key)
+        {
+            entry.observer = observer;
+            entry.unused_timer.start(unused_timeout);
+            return entry.visible;
+        }
+    }
+
+    entries.emplace_back();
+    auto& entry = entries.back();
+    entry.mode = mode;
+    entry.key = key;
+    entry.observer = observer;
+    entry.unused_timer.start(unused_timeout);
+    refresh(entry);
+    return entry.visible;
+}
+
+void RadarVisibilitySystem::refresh(Entry& entry)
+{
+    entry.visible = sp::Bitset();
+    switch(entry.mode)
+    {
+    case Mode::FriendlyShortRange:
+        // Reveal objects if they are within short-range radar range (or 5U) of
+        // a friendly ship, station, or scan probe.
+        for(auto [entity, ssrr, transform] : sp::ecs::Query<ShareShortRangeRadar, sp::Transform>())
+        {
+            // Objects that can't hide in a nebula are revealed below, but don't reveal others.
+            if (entity.hasComponent<NeverRadarBlocked>())
+                continue;
+
+            // Consider the object only if it is:
+            // - Any ShipTemplateBasedObject (ship or station)
+            // - A SpaceObject belonging to a friendly faction
+            // - The player's ship
+            // - A scan probe owned by the player's ship
+            // This check is duplicated in RelayScreen::onDraw.
+            if (Faction::getRelation(entry.observer, entity) != FactionRelation::Friendly)
+                continue;
+
+            // Set the radius to reveal as getShortRangeRadarRange() if the
+            // object's a ShipTemplateBasedObject. Otherwise, default to 5U.
+            float r = entity.getComponent<LongRangeRadar>() ? entity.getComponent<LongRangeRadar>()->short_range : 5000.0f;
+
+            // Query for objects within short-range radar/5U of this object.
+            auto position = transform.getPosition();
+
+            // For each of those objects, check if it is at least partially
+            // inside the revealed radius. If so, reveal the object on the map.
+            for(auto entity2 : sp::CollisionSystem::queryArea(position - glm::vec2(r, r), position + glm::vec2(r, r)))
+            {
+                //TODO: This isn't great, as not everything will collision attached...
+                auto trace = entity2.getComponent<RadarTrace>();
+                float r2 = r + (trace ? trace->radius : 300.0f);
+                if (auto t2 = entity2.getComponent<sp::Transform>()) {
+                    if (glm::length2(position - t2->getPosition()) < r2*r2)
+                        entry.visible.set(entity2.getIndex());
+                }
+            }
+        }
+
+        // If the object can't hide in a nebula, it's considered visible.
+        for(auto [entity, nrb, transform] : sp::ecs::Query<NeverRadarBlocked, sp::Transform>())
+            entry.visible.set(entity.getIndex());
+        break;
+    case Mode::Nebula:
+        if (auto transform = entry.observer.getComponent<sp::Transform>())
+        {
+            auto lrr = entry.observer.getComponent<LongRangeRadar>();
+            auto short_range = lrr ? lrr->short_range : 5000.0f;
+            for(auto [entity, t] : sp::ecs::Query<sp::Transform>())
+            {
+                if (RadarBlockSystem::isRadarBlockedFrom(transform->getPosition(), entity, short_range))
+                    continue;
+                entry.visible.set(entity.getIndex());
+            }
+        }
+        break;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <ecs/system.h>
+#include <ecs/entity.h>
+#include <container/bitset.h>
+#include <timer.h>
+#include <vector>
+
+
+//Fog of war visibility, shared by all radar views on this client.
+//  Results are cached per faction (friendly short range radar) or per observer (nebula blocking),
+//  and refreshed at a fixed real time rate instead of on every frame of every radar view.
+class RadarVisibilitySystem : public sp::ecs::System
+{
+public:
+    enum class Mode
+    {
+        FriendlyShortRange,
+        Nebula,
+    };
+
+    RadarVisibilitySystem();
+
+    void update(float delta) override;
+
+    //The returned reference is only valid until the next call.
+    static const sp::Bitset& getVisibleObjects(Mode mode, sp::ecs::Entity observer);
+private:
+    struct Entry
+    {
+        Mode mode;
+        sp::ecs::Entity key; //Faction entity of the observer for FriendlyShortRange, the observer itself for Nebula.
+        sp::ecs::Entity observer;
+        sp::Bitset visible;
+        sp::SystemTimer unused_timer;
+    };
+
+    static void refresh(Entry& entry);
+
+    static constexpr float refresh_interval = 0.1f;
+    static constexpr float unused_timeout = 1.0f;
+    static std::vector<Entry> entries;
+    //Real time, so objects the GM spawns or moves while the game is paused still show up.
+    sp::SystemTimer refresh_timer;
+};
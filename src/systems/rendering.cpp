@@ -1,12 +1,15 @@
 #include "systems/rendering.h"
 #include "components/rendering.h"
 #include "textureManager.h"
+#include "textureStreamer.h"
 #include "vectorUtils.h"
 #include "shaderRegistry.h"
 #include <graphics/opengl.h>
 #include <glm/gtc/type_ptr.hpp>
 #include "tween.h"
 #include "random.h"
+#include <algorithm>
+#include <cstddef>
 
 
 std::vector<RenderSystem::RenderHandler> RenderSystem::render_handlers;
@@ -37,15 +40,24 @@ void RenderSystem::render3D(float aspect, float camera_fov)
         for(auto info : render_list)
             if (!info.transparent)
                 info.call_rif(info.rif, info.entity, *info.transform, info.component_ptr);
+        flushHandlers(false);
         glEnable(GL_BLEND);
         glBlendFunc(GL_ONE, GL_ONE);
         glDepthMask(false);
         for(auto info : render_list)
             if (info.transparent)
                 info.call_rif(info.rif, info.entity, *info.transform, info.component_ptr);
+        flushHandlers(true);
     }
 }
 
+void RenderSystem::flushHandlers(bool transparent)
+{
+    for(auto& handler : render_handlers)
+        if (handler.transparent == transparent)
+            handler.flush(handler.rif);
+}
+
 glm::mat4 calculateModelMatrix(glm::vec2 position, float rotation, glm::vec3 mesh_offset, float scale) {
     auto model_matrix = glm::translate(glm::identity<glm::mat4>(), glm::vec3{ position.x, position.y, 0.f });
     model_matrix = glm::rotate(model_matrix, glm::radians(rotation), glm::vec3{ 0.f, 0.f, 1.f });
@@ -134,52 +146,87 @@ void NebulaRenderSystem::update(float delta)
 
 void NebulaRenderSystem::render3D(sp::ecs::Entity e, sp::Transform& transform, NebulaRenderer& nr)
 {
-    ShaderRegistry::ScopedShader shader(ShaderRegistry::Shaders::Billboard);
-
-    struct VertexAndTexCoords
-    {
-        glm::vec3 vertex;
-        glm::vec2 texcoords;
-    };
-    std::array<VertexAndTexCoords, 4> quad{
-        glm::vec3{}, {0.f, 1.f},
-        glm::vec3{}, {1.f, 1.f},
-        glm::vec3{}, {1.f, 0.f},
-        glm::vec3{}, {0.f, 0.f}
-    };
-
-    gl::ScopedVertexAttribArray positions(shader.get().attribute(ShaderRegistry::Attributes::Position));
-    gl::ScopedVertexAttribArray texcoords(shader.get().attribute(ShaderRegistry::Attributes::Texcoords));
-
     for(auto& cloud : nr.clouds)
     {
         glm::vec3 position = glm::vec3(transform.getPosition().x, transform.getPosition().y, 0) + glm::vec3(cloud.offset.x, cloud.offset.y, 0);
-        float size = cloud.size;
+        // Clouds beyond the render range are fully faded out, skip them. The fade itself is done in the shader.
+        if (glm::length(camera_position - position) > nr.render_range)
+            continue;
 
-        float distance = glm::length(camera_position - position);
-        float alpha = 1.0f - (distance / nr.render_range);
-        if (alpha < 0.0f)
+        if (!cloud.texture.ptr)
+            cloud.texture.ptr = getStreamedTexture(cloud.texture.name);
+        if (!cloud.texture.ptr)
             continue;
+        // Clouds are drawn offset once more from their fade position, as the per-cloud model matrix used to do.
+        clouds.push_back({cloud.texture.ptr, position, {cloud.size, nr.render_range, cloud.offset.x, cloud.offset.y}});
+    }
+}
+
+void NebulaRenderSystem::flush3D()
+{
+    if (clouds.empty())
+        return;
 
-        // setup our quad.
-        for (auto& point : quad)
+    if (!buffers[0])
+    {
+        buffers = gl::Buffers<2>{};
+        std::vector<uint16_t> elements(max_clouds_per_draw * 6);
+        for(size_t n=0; n<max_clouds_per_draw; n++)
         {
-            point.vertex = position;
+            auto base = static_cast<uint16_t>(n * 4);
+            uint16_t quad[6] = {0, 3, 2, 0, 2, 1};
+            for(size_t i=0; i<6; i++)
+                elements[n * 6 + i] = base + quad[i];
         }
+        gl::ScopedBufferBinding element_buffer(GL_ELEMENT_ARRAY_BUFFER, buffers[1]);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, elements.size() * sizeof(uint16_t), elements.data(), GL_STATIC_DRAW);
+    }
 
-        if (!cloud.texture.ptr)
-            cloud.texture.ptr = textureManager.getTexture(cloud.texture.name);
-        if (cloud.texture.ptr)
-            cloud.texture.ptr->bind();
-        glUniform4f(shader.get().uniform(ShaderRegistry::Uniforms::Color), alpha * 0.8f, alpha * 0.8f, alpha * 0.8f, size);
-        auto cloud_model_matrix = glm::translate(glm::identity<glm::mat4>(), {cloud.offset.x, cloud.offset.y, 0});
-        glUniformMatrix4fv(shader.get().uniform(ShaderRegistry::Uniforms::Model), 1, GL_FALSE, glm::value_ptr(cloud_model_matrix));
-
-        glVertexAttribPointer(positions.get(), 3, GL_FLOAT, GL_FALSE, sizeof(VertexAndTexCoords), (GLvoid*)quad.data());
-        glVertexAttribPointer(texcoords.get(), 2, GL_FLOAT, GL_FALSE, sizeof(VertexAndTexCoords), (GLvoid*)((char*)quad.data() + sizeof(glm::vec3)));
-        std::initializer_list<uint16_t> indices = { 0, 3, 2, 0, 2, 1 };
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, std::begin(indices));
+    // Group the clouds by texture, so each texture is bound and drawn once.
+    std::sort(clouds.begin(), clouds.end(), [](const CloudInstance& a, const CloudInstance& b) { return a.texture < b.texture; });
+
+    static const glm::vec2 quad_texcoords[4] = {{0.f, 1.f}, {1.f, 1.f}, {1.f, 0.f}, {0.f, 0.f}};
+    vertices.resize(clouds.size() * 4);
+    for(size_t n=0; n<clouds.size(); n++)
+        for(size_t v=0; v<4; v++)
+            vertices[n * 4 + v] = {clouds[n].position, quad_texcoords[v], clouds[n].parameters};
+
+    ShaderRegistry::ScopedShader shader(ShaderRegistry::Shaders::Nebula);
+    glUniform3fv(shader.get().uniform(ShaderRegistry::Uniforms::CameraPosition), 1, glm::value_ptr(camera_position));
+
+    gl::ScopedBufferBinding vertex_buffer(GL_ARRAY_BUFFER, buffers[0]);
+    gl::ScopedBufferBinding element_buffer(GL_ELEMENT_ARRAY_BUFFER, buffers[1]);
+    if (vertices.size() > vertex_buffer_capacity)
+    {
+        vertex_buffer_capacity = vertices.size();
+        glBufferData(GL_ARRAY_BUFFER, vertex_buffer_capacity * sizeof(CloudVertex), vertices.data(), GL_DYNAMIC_DRAW);
+    }
+    else
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(CloudVertex), vertices.data());
+    }
+
+    gl::ScopedVertexAttribArray positions(shader.get().attribute(ShaderRegistry::Attributes::Position));
+    gl::ScopedVertexAttribArray texcoords(shader.get().attribute(ShaderRegistry::Attributes::Texcoords));
+    gl::ScopedVertexAttribArray parameters(shader.get().attribute(ShaderRegistry::Attributes::CloudParameters));
+
+    for(size_t first=0; first<clouds.size();)
+    {
+        auto texture = clouds[first].texture;
+        size_t count = 1;
+        while(first + count < clouds.size() && clouds[first + count].texture == texture && count < max_clouds_per_draw)
+            count++;
+
+        // ES2 has no base vertex for draws, so offset the attribute pointers instead.
+        auto base = reinterpret_cast<const uint8_t*>(first * 4 * sizeof(CloudVertex));
+        glVertexAttribPointer(positions.get(), 3, GL_FLOAT, GL_FALSE, sizeof(CloudVertex), base + offsetof(CloudVertex, position));
+        glVertexAttribPointer(texcoords.get(), 2, GL_FLOAT, GL_FALSE, sizeof(CloudVertex), base + offsetof(CloudVertex, texcoords));
+        glVertexAttribPointer(parameters.get(), 4, GL_FLOAT, GL_FALSE, sizeof(CloudVertex), base + offsetof(CloudVertex, parameters));
+        texture->bind();
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(count * 6), GL_UNSIGNED_SHORT, nullptr);
+        first += count;
     }
+    clouds.clear();
 }
 
 void ExplosionRenderSystem::update(float delta)
@@ -6,19 +6,26 @@
 #include "components/collision.h"
 #include "components/rendering.h"
 #include "main.h"
+#include "glObjects.h"
 #include <glm/geometric.hpp>
+#include <limits>
+#include <vector>
 
 template<typename COMPONENT, bool TRANSPARENT> class Render3DInterface {
 public:
     Render3DInterface();
     virtual void render3D(sp::ecs::Entity e, sp::Transform& transform, COMPONENT& component) = 0;
+    // Called once all entities of a render pass have been passed to render3D, for handlers that batch their draws.
+    virtual void flush3D() {}
 };
 
 class RenderSystem
 {
 public:
     template<typename COMPONENT, bool TRANSPARENT> static void add3DHandler(Render3DInterface<COMPONENT, TRANSPARENT>* rif) {
-        render_handlers.push_back({rif, &RenderSystem::findRenderObjects<COMPONENT, TRANSPARENT>});
+        render_handlers.push_back({rif, TRANSPARENT, &RenderSystem::findRenderObjects<COMPONENT, TRANSPARENT>, [](void* rif_ptr) {
+            reinterpret_cast<Render3DInterface<COMPONENT, TRANSPARENT>*>(rif_ptr)->flush3D();
+        }});
     }
 
     void render3D(float aspect, float camera_fov);
@@ -63,8 +70,11 @@ private:
 
     struct RenderHandler {
         void* rif;
+        bool transparent;
         void (RenderSystem::* func)(void* rif);
+        void (*flush)(void* rif);
     };
+    void flushHandlers(bool transparent);
     static std::vector<RenderHandler> render_handlers;
 };
 
@@ -83,11 +93,32 @@ public:
     void render3D(sp::ecs::Entity e, sp::Transform& transform, MeshRenderComponent& mrc) override;
 };
 
+// Nebula clouds of all entities are collected during the pass, and drawn with a single draw call per texture in flush3D.
 class NebulaRenderSystem : public sp::ecs::System, public Render3DInterface<NebulaRenderer, true>
 {
 public:
     void update(float delta) override;
     void render3D(sp::ecs::Entity e, sp::Transform& transform, NebulaRenderer& nr) override;
+    void flush3D() override;
+private:
+    struct CloudInstance
+    {
+        sp::Texture* texture;
+        glm::vec3 position;
+        glm::vec4 parameters; // size, render range, draw offset x/y
+    };
+    struct CloudVertex
+    {
+        glm::vec3 position;
+        glm::vec2 texcoords;
+        glm::vec4 parameters;
+    };
+    static constexpr size_t max_clouds_per_draw = (std::numeric_limits<uint16_t>::max() + 1) / 4;
+
+    std::vector<CloudInstance> clouds;
+    std::vector<CloudVertex> vertices;
+    gl::Buffers<2> buffers{ gl::Unitialized{} }; // vertex, element
+    size_t vertex_buffer_capacity = 0;
 };
 
 class ExplosionRenderSystem : public sp::ecs::System, public Render3DInterface<ExplosionEffect, true>
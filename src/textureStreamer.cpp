@@ -0,0 +1,282 @@
+#include "textureStreamer.h"
+#include "textureManager.h"
+#include "graphics/image.h"
+#include "resources.h"
+#include "logging.h"
+
+#include <graphics/opengl.h>
+#include <algorithm>
+#include <string.h>
+
+P<TextureStreamer> textureStreamer;
+
+static constexpr int preview_max_size = 32;
+
+//Lets the image loader decode a file that was already read into memory by the main thread.
+class MemoryResourceStream : public ResourceStream
+{
+    std::vector<uint8_t> buffer;
+    size_t read_position = 0;
+public:
+    MemoryResourceStream(std::vector<uint8_t>&& buffer) : buffer(std::move(buffer)) {}
+
+    virtual size_t read(void* data, size_t size) override
+    {
+        size = std::min(size, buffer.size() - read_position);
+        memcpy(data, buffer.data() + read_position, size);
+        read_position += size;
+        return size;
+    }
+    virtual size_t seek(size_t position) override { read_position = std::min(position, buffer.size()); return read_position; }
+    virtual size_t tell() override { return read_position; }
+    virtual size_t getSize() override { return buffer.size(); }
+};
+
+void StreamedTexture::bind()
+{
+    if (state == State::Preview || state == State::Loaded)
+        glBindTexture(GL_TEXTURE_2D, handle[0]);
+    else
+        glBindTexture(GL_TEXTURE_2D, placeholder);
+}
+
+TextureStreamer::TextureStreamer()
+{
+    textureStreamer = this;
+
+    //Fully transparent, so additive effects (nebulae, billboards) simply fade in once loaded.
+    placeholder = gl::Textures<1>{};
+    const uint8_t transparent[4] = {0, 0, 0, 0};
+    upload(placeholder[0], {1, 1}, transparent, false);
+
+    //Image decoding is CPU bound, but we leave room for the main thread and the network/audio threads.
+    unsigned int worker_count = std::clamp(std::thread::hardware_concurrency() / 2, 1U, 2U);
+    for(unsigned int n=0; n<worker_count; n++)
+        workers.emplace_back(&TextureStreamer::workerLoop, this);
+}
+
+TextureStreamer::~TextureStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_available.notify_all();
+    for(auto& worker : workers)
+        worker.join();
+}
+
+sp::Texture* TextureStreamer::getTexture(const string& name)
+{
+    return request(name);
+}
+
+void TextureStreamer::preload(const string& name)
+{
+    request(name);
+}
+
+void TextureStreamer::preloadManifest(const string& manifest_name)
+{
+    P<ResourceStream> stream = getResourceStream(manifest_name);
+    if (!stream)
+        return;
+    int count = 0;
+    while(stream->tell() < stream->getSize())
+    {
+        string line = stream->readLine().strip();
+        if (line.empty() || line.startswith("#"))
+            continue;
+        request(line);
+        count++;
+    }
+    LOG(INFO) << "Preloading " << count << " textures from " << manifest_name;
+}
+
+StreamedTexture* TextureStreamer::request(const string& name)
+{
+    auto it = textures.find(name);
+    if (it != textures.end())
+        return it->second.get();
+
+    auto texture = std::make_unique<StreamedTexture>();
+    texture->name = name;
+    texture->placeholder = placeholder[0];
+    auto ptr = texture.get();
+    textures[name] = std::move(texture);
+    read_queue.push_back(ptr);
+    return ptr;
+}
+
+void TextureStreamer::readFiles()
+{
+    //Reading is limited by the same budget as uploading, but at least one file is read per frame.
+    size_t read = 0;
+    while(!read_queue.empty() && (read == 0 || read < upload_budget))
+    {
+        auto texture = read_queue.front();
+        read_queue.pop_front();
+
+        P<ResourceStream> stream = getResourceStream(texture->name);
+        if (!stream)
+        {
+            LOG(WARNING) << "Failed to load texture: " << texture->name;
+            texture->state = StreamedTexture::State::Failed;
+            continue;
+        }
+        EncodedImage image;
+        image.texture = texture;
+        image.data.resize(stream->getSize());
+        image.data.resize(stream->read(image.data.data(), image.data.size()));
+        read += std::max(image.data.size(), size_t(1));
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            decode_queue.push_back(std::move(image));
+        }
+        work_available.notify_one();
+    }
+}
+
+void TextureStreamer::workerLoop()
+{
+    while(true)
+    {
+        EncodedImage encoded;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_available.wait(lock, [this]() { return stopping || !decode_queue.empty(); });
+            if (stopping)
+                return;
+            encoded = std::move(decode_queue.front());
+            decode_queue.pop_front();
+        }
+
+        DecodedImage image;
+        image.texture = encoded.texture;
+        decode(image, std::move(encoded.data));
+
+        std::lock_guard<std::mutex> lock(mutex);
+        decoded.push_back(std::move(image));
+    }
+}
+
+void TextureStreamer::decode(DecodedImage& image, std::vector<uint8_t>&& data)
+{
+    sp::Image source;
+    //This stream is only ever referenced from this thread, so its reference count is never shared.
+    P<ResourceStream> stream = new MemoryResourceStream(std::move(data));
+    if (!source.loadFromStream(stream))
+        return;
+    image.ok = true;
+    image.size = source.getSize();
+    auto pixels = reinterpret_cast<const uint8_t*>(source.getPtr());
+    image.pixels.assign(pixels, pixels + size_t(image.size.x) * size_t(image.size.y) * 4);
+
+    //Box filtered preview, so something representative shows while the full image waits for its upload budget.
+    int factor = 1;
+    while(image.size.x / factor > preview_max_size || image.size.y / factor > preview_max_size)
+        factor *= 2;
+    if (factor == 1)
+        return;
+    image.preview_size = {std::max(1, image.size.x / factor), std::max(1, image.size.y / factor)};
+    image.preview_pixels.resize(size_t(image.preview_size.x) * size_t(image.preview_size.y) * 4);
+    for(int y=0; y<image.preview_size.y; y++)
+    {
+        for(int x=0; x<image.preview_size.x; x++)
+        {
+            uint32_t sum[4] = {0, 0, 0, 0};
+            int samples = 0;
+            for(int sy=y*factor; sy<std::min((y+1)*factor, image.size.y); sy++)
+            {
+                for(int sx=x*factor; sx<std::min((x+1)*factor, image.size.x); sx++)
+                {
+                    auto p = &image.pixels[(size_t(sy) * image.size.x + sx) * 4];
+                    for(int c=0; c<4; c++)
+                        sum[c] += p[c];
+                    samples++;
+                }
+            }
+            auto dst = &image.preview_pixels[(size_t(y) * image.preview_size.x + x) * 4];
+            for(int c=0; c<4; c++)
+                dst[c] = uint8_t(sum[c] / std::max(samples, 1));
+        }
+    }
+}
+
+void TextureStreamer::upload(uint32_t handle, glm::ivec2 size, const uint8_t* pixels, bool mipmaps)
+{
+    glBindTexture(GL_TEXTURE_2D, handle);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    //GLES2 does not allow repeating or mipmapping non power of two textures.
+    bool power_of_two = (size.x & (size.x - 1)) == 0 && (size.y & (size.y - 1)) == 0;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    if (mipmaps && power_of_two)
+    {
+        //Same filtering as the textures from the TextureManager, so distant objects do not shimmer.
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    }
+    else
+    {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, power_of_two ? GL_REPEAT : GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, power_of_two ? GL_REPEAT : GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void TextureStreamer::update(float delta)
+{
+    readFiles();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for(auto& image : decoded)
+            pending_upload.push_back(std::move(image));
+        decoded.clear();
+    }
+
+    //Previews are tiny, upload all of them right away.
+    for(auto& image : pending_upload)
+    {
+        if (!image.ok || image.preview_uploaded || image.preview_pixels.empty())
+            continue;
+        auto texture = image.texture;
+        texture->handle = gl::Textures<1>{};
+        upload(texture->handle[0], image.preview_size, image.preview_pixels.data(), false);
+        texture->state = StreamedTexture::State::Preview;
+        image.preview_uploaded = true;
+        image.preview_pixels.clear();
+    }
+
+    //Full images in request order, until the budget is used up. At least one image is uploaded per frame,
+    //  so textures larger than the budget still arrive.
+    size_t uploaded = 0;
+    while(!pending_upload.empty())
+    {
+        auto& image = pending_upload.front();
+        auto texture = image.texture;
+        if (!image.ok)
+        {
+            LOG(WARNING) << "Failed to load texture: " << texture->name;
+            texture->state = StreamedTexture::State::Failed;
+            pending_upload.pop_front();
+            continue;
+        }
+        if (uploaded > 0 && uploaded + image.pixels.size() > upload_budget)
+            break;
+        if (texture->state != StreamedTexture::State::Preview)
+            texture->handle = gl::Textures<1>{};
+        upload(texture->handle[0], image.size, image.pixels.data(), true);
+        texture->state = StreamedTexture::State::Loaded;
+        uploaded += image.pixels.size();
+        pending_upload.pop_front();
+    }
+}
+
+sp::Texture* getStreamedTexture(const string& name)
+{
+    if (textureStreamer)
+        return textureStreamer->getTexture(name);
+    return textureManager.getTexture(name);
+}
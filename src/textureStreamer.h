@@ -0,0 +1,105 @@
+#ifndef TEXTURE_STREAMER_H
+#define TEXTURE_STREAMER_H
+
+#include "Updatable.h"
+#include "graphics/texture.h"
+#include "glObjects.h"
+#include "stringImproved.h"
+
+#include <glm/vec2.hpp>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//Texture that is loaded in the background by the TextureStreamer.
+//  Binding it before it is ready binds a placeholder: first a shared transparent texel,
+//  then a low resolution preview, and finally the full resolution image.
+class StreamedTexture : public sp::Texture
+{
+public:
+    virtual void bind() override;
+
+    bool isLoaded() const { return state == State::Loaded; }
+private:
+    enum class State
+    {
+        Queued,
+        Preview,
+        Loaded,
+        Failed,
+    };
+
+    string name;
+    State state = State::Queued;
+    gl::Textures<1> handle{ gl::Unitialized{} };
+    uint32_t placeholder = 0;
+
+    friend class TextureStreamer;
+};
+
+//Decodes textures on worker threads, and uploads them to the GPU with a per frame byte budget.
+//  Created on clients with a display, so first use of a texture never stalls the render loop.
+//  Files are read on the main thread, as the resource providers are not thread safe. Only the decoding is done by the workers.
+class TextureStreamer : public Updatable
+{
+public:
+    TextureStreamer();
+    virtual ~TextureStreamer();
+
+    //Never returns nullptr, the returned texture shows a placeholder until it has been streamed in.
+    sp::Texture* getTexture(const string& name);
+    //Start loading a texture before it is first drawn.
+    void preload(const string& name);
+    //Preload every texture listed in a resource file, one texture name per line. Lines starting with # are ignored.
+    void preloadManifest(const string& manifest_name);
+
+    void setUploadBudget(size_t bytes_per_frame) { upload_budget = bytes_per_frame; }
+
+    virtual void update(float delta) override;
+private:
+    struct EncodedImage
+    {
+        StreamedTexture* texture;
+        std::vector<uint8_t> data;
+    };
+    struct DecodedImage
+    {
+        StreamedTexture* texture;
+        bool ok = false;
+        glm::ivec2 size{};
+        std::vector<uint8_t> pixels;
+        glm::ivec2 preview_size{};
+        std::vector<uint8_t> preview_pixels;
+        bool preview_uploaded = false;
+    };
+
+    StreamedTexture* request(const string& name);
+    void workerLoop();
+    void readFiles();
+    static void decode(DecodedImage& image, std::vector<uint8_t>&& data);
+    static void upload(uint32_t handle, glm::ivec2 size, const uint8_t* pixels, bool mipmaps);
+
+    std::unordered_map<string, std::unique_ptr<StreamedTexture>> textures;
+    gl::Textures<1> placeholder{ gl::Unitialized{} };
+    size_t upload_budget = 4 * 1024 * 1024;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_available;
+    bool stopping = false;
+    std::deque<StreamedTexture*> read_queue; //Only used by the main thread.
+    std::deque<EncodedImage> decode_queue;
+    std::deque<DecodedImage> decoded; //Guarded by mutex, moved to pending_upload by the main thread.
+    std::deque<DecodedImage> pending_upload;
+};
+
+extern P<TextureStreamer> textureStreamer;
+
+//Get a texture through the streamer when there is one, and fall back to the (synchronous) TextureManager otherwise.
+sp::Texture* getStreamedTexture(const string& name);
+
+#endif//TEXTURE_STREAMER_H
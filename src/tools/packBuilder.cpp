@@ -0,0 +1,276 @@
+// Builds version 1 .pack files from resource directories.
+//
+// Usage: pack_builder [--no-compress] [directory...]
+//   Without directories, every subdirectory of the current working directory is packed into <name>.pack,
+//   with a <name>.packlist listing the contents. Wavefront .obj files are converted into pre-indexed .model files.
+#include "packFormat.h"
+
+#include <meshoptimizer.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct ModelVertex
+{
+    float position[3];
+    float normal[3];
+    float uv[2];
+};
+
+static bool readFile(const fs::path& path, std::vector<uint8_t>& data)
+{
+    std::ifstream f(path, std::ios::binary);
+    if (!f)
+        return false;
+    data.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static void appendInt(std::vector<uint8_t>& data, int32_t value)
+{
+    uint8_t buffer[4];
+    pack::writeU32(buffer, uint32_t(value));
+    data.insert(data.end(), buffer, buffer + 4);
+}
+
+static bool convertObj(const fs::path& path, std::vector<uint8_t>& data)
+{
+    std::ifstream f(path);
+    if (!f)
+        return false;
+
+    std::vector<std::vector<float>> vertices, normals, uvs;
+    std::vector<ModelVertex> soup;
+    std::string line;
+    while(std::getline(f, line))
+    {
+        std::istringstream parts(line);
+        std::string type;
+        if (!(parts >> type))
+            continue;
+        if (type == "v" || type == "vn" || type == "vt")
+        {
+            std::vector<float> values;
+            float value;
+            while(parts >> value)
+                values.push_back(value);
+            values.resize(3, 0.0f);
+            (type == "v" ? vertices : type == "vn" ? normals : uvs).push_back(values);
+        }
+        else if (type == "f")
+        {
+            std::vector<ModelVertex> face;
+            std::string corner;
+            while(parts >> corner)
+            {
+                int v = 0, t = 0, n = 0;
+                if (sscanf(corner.c_str(), "%d/%d/%d", &v, &t, &n) != 3
+                    || v < 1 || size_t(v) > vertices.size() || t < 1 || size_t(t) > uvs.size() || n < 1 || size_t(n) > normals.size())
+                {
+                    fprintf(stderr, "%s: bad face: %s\n", path.string().c_str(), line.c_str());
+                    return false;
+                }
+                const auto& pos = vertices[v - 1];
+                const auto& nor = normals[n - 1];
+                const auto& uv = uvs[t - 1];
+                face.push_back(ModelVertex{{pos[0], pos[2], pos[1]}, {nor[0], nor[2], nor[1]}, {uv[0], 1.0f - uv[1]}});
+            }
+            for(size_t i=2; i<face.size(); i++)
+            {
+                soup.push_back(face[0]);
+                soup.push_back(face[i - 1]);
+                soup.push_back(face[i]);
+            }
+        }
+    }
+
+    std::vector<uint32_t> remap(soup.size());
+    size_t vertex_count = meshopt_generateVertexRemap(remap.data(), nullptr, soup.size(), soup.data(), soup.size(), sizeof(ModelVertex));
+    if (vertex_count > 0xFFFF)
+    {
+        //The renderer only supports 16 bit indices, store these as plain triangle lists.
+        appendInt(data, int32_t(soup.size()));
+        auto bytes = reinterpret_cast<const uint8_t*>(soup.data());
+        data.insert(data.end(), bytes, bytes + soup.size() * sizeof(ModelVertex));
+        return true;
+    }
+
+    std::vector<uint32_t> indices(soup.size());
+    std::vector<ModelVertex> indexed_vertices(vertex_count);
+    meshopt_remapIndexBuffer(indices.data(), nullptr, soup.size(), remap.data());
+    meshopt_remapVertexBuffer(indexed_vertices.data(), soup.data(), soup.size(), sizeof(ModelVertex), remap.data());
+    meshopt_optimizeVertexCache(indices.data(), indices.data(), indices.size(), vertex_count);
+    std::vector<uint16_t> indices16(indices.begin(), indices.end());
+
+    appendInt(data, pack::indexed_model_marker);
+    appendInt(data, int32_t(indexed_vertices.size()));
+    appendInt(data, int32_t(indices16.size()));
+    auto vertex_bytes = reinterpret_cast<const uint8_t*>(indexed_vertices.data());
+    data.insert(data.end(), vertex_bytes, vertex_bytes + indexed_vertices.size() * sizeof(ModelVertex));
+    auto index_bytes = reinterpret_cast<const uint8_t*>(indices16.data());
+    data.insert(data.end(), index_bytes, index_bytes + indices16.size() * sizeof(uint16_t));
+    return true;
+}
+
+static bool buildPack(const fs::path& directory, bool compress)
+{
+    std::map<std::string, std::vector<uint8_t>> files; //std::map keeps the names sorted, as the reader expects.
+    for(auto it = fs::recursive_directory_iterator(directory); it != fs::recursive_directory_iterator(); ++it)
+    {
+        //Resources are at most three directory levels deep.
+        if (it.depth() > 2 || !it->is_regular_file())
+            continue;
+        fs::path path = it->path();
+        std::string name = fs::relative(path, directory).generic_string();
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (extension == ".rar" || extension == ".zip")
+            continue;
+
+        std::vector<uint8_t> data;
+        bool ok;
+        if (extension == ".obj")
+        {
+            name = name.substr(0, name.size() - extension.size()) + ".model";
+            ok = convertObj(path, data);
+        }
+        else
+        {
+            ok = readFile(path, data);
+        }
+        if (!ok)
+        {
+            fprintf(stderr, "Failed to read %s\n", path.string().c_str());
+            return false;
+        }
+        if (name.size() > 0xFFFF)
+        {
+            fprintf(stderr, "Name too long: %s\n", name.c_str());
+            return false;
+        }
+        files[name] = std::move(data);
+    }
+
+    //Twice the entry count, rounded up to a power of 2, keeps the probe sequences short.
+    uint32_t slot_count = 1;
+    while(slot_count < files.size() * 2)
+        slot_count <<= 1;
+
+    std::vector<uint8_t> names;
+    std::vector<pack::EntryRecord> records;
+    std::vector<std::vector<uint8_t>> payloads;
+    std::vector<uint32_t> slots(slot_count, 0);
+    for(auto& [name, data] : files)
+    {
+        pack::EntryRecord record{};
+        record.name_offset = uint32_t(names.size());
+        record.name_length = uint16_t(name.size());
+        record.size = uint32_t(data.size());
+        record.content_hash = pack::contentHash(data.data(), data.size());
+        record.compression = pack::Compression::None;
+        if (compress)
+        {
+            auto compressed = pack::lz4Compress(data.data(), data.size());
+            if (compressed.size() < data.size())
+            {
+                record.compression = pack::Compression::LZ4;
+                data = std::move(compressed);
+            }
+        }
+        record.stored_size = uint32_t(data.size());
+        names.insert(names.end(), name.begin(), name.end());
+
+        uint32_t slot = pack::nameHash(name.data(), name.size()) & (slot_count - 1);
+        while(slots[slot] != 0)
+            slot = (slot + 1) & (slot_count - 1);
+        slots[slot] = uint32_t(records.size() + 1);
+
+        records.push_back(record);
+        payloads.push_back(std::move(data));
+    }
+
+    size_t offset = pack::header_size_v1 + records.size() * pack::entry_record_size + slots.size() * sizeof(uint32_t) + names.size();
+    for(size_t n=0; n<records.size(); n++)
+    {
+        records[n].position = uint32_t(offset);
+        offset += payloads[n].size();
+    }
+    if (offset > 0xFFFFFFFFULL)
+    {
+        fprintf(stderr, "%s is too large for a single pack\n", directory.string().c_str());
+        return false;
+    }
+
+    std::vector<uint8_t> header(pack::header_size_v1 + records.size() * pack::entry_record_size + slots.size() * sizeof(uint32_t));
+    pack::writeU32(header.data(), pack::format_version_1);
+    pack::writeU32(header.data() + 4, uint32_t(records.size()));
+    pack::writeU32(header.data() + 8, slot_count);
+    uint8_t* ptr = header.data() + pack::header_size_v1;
+    for(auto& record : records)
+    {
+        record.write(ptr);
+        ptr += pack::entry_record_size;
+    }
+    for(auto slot : slots)
+    {
+        pack::writeU32(ptr, slot);
+        ptr += sizeof(uint32_t);
+    }
+
+    std::string pack_name = (directory.has_filename() ? directory : directory.parent_path()).filename().string();
+    std::ofstream f(pack_name + ".pack", std::ios::binary);
+    std::ofstream flog(pack_name + ".packlist");
+    f.write(reinterpret_cast<const char*>(header.data()), header.size());
+    f.write(reinterpret_cast<const char*>(names.data()), names.size());
+    for(auto& payload : payloads)
+        f.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+    size_t stored_total = 0, total = 0;
+    for(const auto& record : records)
+    {
+        stored_total += record.stored_size;
+        total += record.size;
+    }
+    for(const auto& [name, data] : files)
+        flog << name << "\n";
+    if (!f)
+    {
+        fprintf(stderr, "Failed to write %s.pack\n", pack_name.c_str());
+        return false;
+    }
+    printf("%s.pack: %zu files, %zu bytes (%zu uncompressed)\n", pack_name.c_str(), records.size(), stored_total, total);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    bool compress = true;
+    std::vector<fs::path> directories;
+    for(int n=1; n<argc; n++)
+    {
+        if (strcmp(argv[n], "--no-compress") == 0)
+            compress = false;
+        else
+            directories.emplace_back(fs::path(argv[n]).lexically_normal());
+    }
+    if (directories.empty())
+    {
+        for(const auto& entry : fs::directory_iterator("."))
+            if (entry.is_directory())
+                directories.push_back(entry.path());
+    }
+
+    int result = 0;
+    for(const auto& directory : directories)
+        if (!buildPack(directory, compress))
+            result = 1;
+    return result;
+}